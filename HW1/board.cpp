@@ -3,11 +3,15 @@
 #include "piece.h"
 #include "player.h"
 #include <cassert>
-#include <iostream>
 #include <cmath>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
 
 using namespace std;
 
+static_assert(is_trivially_copyable<Piece>::value, "the board cells are copied with memcpy");
+
 /**
  * @brief Construct a new Board:: Board object
  * 
@@ -17,13 +21,7 @@ using namespace std;
 Board::Board(int n, int m) {
     _n = n;
     _m = m;
-    _board = new Piece*[n];
-    if (_board) {
-        for (int i=0;i < n; ++i) {
-            _board[i] = new Piece[m];
-            assert(_board[i]);
-        }
-    }
+    _board = new Piece[n * m];
 }
 
 /**
@@ -35,53 +33,93 @@ Board::Board(const Board& b) {
     *this = b;
 }
 
+/**
+ * @brief Construct a new Board:: Board object (Move C'tor), takes the cells of b.
+ * 
+ * @param b The board to move from, left empty (0x0)
+ */
+Board::Board(Board&& b) noexcept {
+    *this = move(b);
+}
+
 /**
  * @brief Destroy the Board:: Board object
  * 
  */
 Board::~Board() {
-    for (int i=0; i < _n; ++i) {
-        delete[] (_board[i]);
-    }
     delete[] _board;
 }
 
 /**
- * @brief Overloading on the assignment (=) operator.
+ * @brief Overloading on the assignment (=) operator. The cells are reused when the dimensions are the same.
  * 
  * @param b The assignment variable
  * @return Board& Reference to the object for reassignment
  */
 Board& Board::operator=(const Board& b) {
-    cout << this << ", " << (*this) << endl;
     if (this != &b) {
-        if (_board != nullptr) {
-            for (int i=0; i < _n; ++i) {
-                delete[] _board[i];
-            }
+        if (_board == nullptr || _n * _m != b._n * b._m) {
             delete[] _board;
+            _board = new Piece[b._n * b._m];
         }
         _n = b._n;
         _m = b._m;
-        _board = new Piece*[_n];
-        if (_board) {
-            for (int i=0;i < _n; ++i) {
-                _board[i] = new Piece[_m];
-                assert(_board[i]);
-            }
+        memcpy(static_cast<void*>(_board), static_cast<const void*>(b._board), _n * _m * sizeof(Piece));
+    }
+    return *this;
+}
+
+/**
+ * @brief Overloading on the move assignment (=) operator, takes the cells of b.
+ * 
+ * @param b The board to move from, left empty (0x0)
+ * @return Board& Reference to the object for reassignment
+ */
+Board& Board::operator=(Board&& b) noexcept {
+    if (this != &b) {
+        delete[] _board;
+        _n = b._n;
+        _m = b._m;
+        _board = b._board;
+        b._n = 0;
+        b._m = 0;
+        b._board = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @brief Merges a single cell based on the rules of the game.
+ * 
+ * @param dest The cell of the calling board
+ * @param src The cell of the merged board
+ */
+void Board::MergeCell(Piece& dest, Piece& src) {
+    if (dest.GetPieceType() == src.GetPieceType()) {
+        dest.RemovePieceFromPlayer();
+        src.RemovePieceFromPlayer();
+        dest.NullifyPiece();
+    } else if (dest.GetPieceType() == PieceType::NONE) {
+        dest = src;
+    } 
+    else {
+        if (dest < src) {
+            dest.RemovePieceFromPlayer();
+            dest = src;
+        } else {
+            src.RemovePieceFromPlayer();
         }
-        for (int i=0;i<_n;++i) {
-            if (!_board[i]) _board[i] = new Piece[_m];
-            for (int j=0;j<_m;++j) {
-                _board[i][j] = b._board[i][j];
-            }
+        if (src.GetPieceType() != PieceType::NONE && dest.GetPieceType() == PieceType::BOMB) {
+            dest.RemovePieceFromPlayer();
+            dest.NullifyPiece();
         }
     }
-    return *this;
 }
 
 /**
  * @brief Merges a second board to the current board based on the rules of the game.
+ * The boards are walked together as flat arrays, and the empty cells of b (most of a player's board) are skipped,
+ * merging an empty cell never changes anything.
  * 
  * @param b The board to merge into the calling board.
  * @return Board& the current board as reference type.
@@ -89,27 +127,11 @@ Board& Board::operator=(const Board& b) {
 Board& Board::Merge(const Board& b) {
     assert(_m == b._m);
     assert(_n == b._n);
-    for (int i=0;i<_n;++i) {
-        for (int j=0;j<_m;++j) {
-            if (_board[i][j].GetPieceType() == b._board[i][j].GetPieceType()) {
-                _board[i][j].RemovePieceFromPlayer();
-                b._board[i][j].RemovePieceFromPlayer();
-                _board[i][j].NullifyPiece();
-            } else if (_board[i][j].GetPieceType() == PieceType::NONE) {
-                _board[i][j] = b._board[i][j];
-            } 
-            else {
-                if (_board[i][j] < b._board[i][j]) {
-                    _board[i][j].RemovePieceFromPlayer();
-                    _board[i][j] = b._board[i][j];
-                } else {
-                    b._board[i][j].RemovePieceFromPlayer();
-                }
-                if (b._board[i][j].GetPieceType() != PieceType::NONE && _board[i][j].GetPieceType() == PieceType::BOMB) {
-                    _board[i][j].RemovePieceFromPlayer();
-                    _board[i][j].NullifyPiece();
-                }
-            }
+    Piece* dest = _board;
+    Piece* src = b._board;
+    for (Piece* end = src + _n * _m; src != end; ++src, ++dest) {
+        if (src->GetPieceType() != PieceType::NONE) {
+            MergeCell(*dest, *src);
         }
     }
     return *this;
@@ -131,7 +153,7 @@ bool Board::PlacePiece(Player* owner, PieceType type, int x, int y, bool is_joke
     if (!IsPositionValid(x, y)) {
         return false;
     }
-    if (_board[x][y].IsInitiated()) {
+    if (At(x, y).IsInitiated()) {
         return false;
     }
     if (is_joker && (type == PieceType::FLAG)) {
@@ -139,7 +161,7 @@ bool Board::PlacePiece(Player* owner, PieceType type, int x, int y, bool is_joke
         return false;
     }
     Piece p(type, is_joker, owner);
-    _board[x][y] = p;
+    At(x, y) = p;
     return true;
 }
 
@@ -154,8 +176,8 @@ bool Board::PlacePiece(Player* owner, PieceType type, int x, int y, bool is_joke
  * @return false The move is illegal.
  */
 bool Board::IsMoveLegal(PlayerType player_type, int x, int y, int new_x, int new_y) {
-    Piece& origin_piece = _board[x][y];
-    Piece& destination_piece = _board[new_x][new_y];
+    Piece& origin_piece = At(x, y);
+    Piece& destination_piece = At(new_x, new_y);
     if (!IsPositionValid(x, y) || !IsPositionValid(new_x, new_y) || !origin_piece.IsInitiated() || player_type != origin_piece.GetPlayerType() || origin_piece.GetPlayerType() == destination_piece.GetPlayerType() || origin_piece.GetPieceType() == PieceType::BOMB || origin_piece.GetPieceType() == PieceType::FLAG || (abs(x - new_x) == 1 && abs(y - new_y) == 1) || abs(x-new_x) > 1 || abs(y - new_y) > 1) {
         return false;
     }
@@ -175,8 +197,8 @@ bool Board::MovePiece(PlayerType p_type, int x, int y, int new_x, int new_y) {
         return false;
     }
 
-    Piece& origin_piece = _board[x][y];
-    Piece& destination_piece = _board[new_x][new_y];
+    Piece& origin_piece = At(x, y);
+    Piece& destination_piece = At(new_x, new_y);
     Piece temp_p;
     if (origin_piece == destination_piece) {
         origin_piece.RemovePieceFromPlayer();
@@ -205,7 +227,7 @@ bool Board::ChangeJoker(PlayerType p_type, int x, int y, PieceType new_type) {
     if (!IsPositionValid(x,y)) {
         return false;
     }
-    Piece& piece = _board[x][y];
+    Piece& piece = At(x, y);
     if (piece.GetPlayerType() != p_type || !piece.IsJoker() || new_type == PieceType::FLAG || new_type == PieceType::JOKER) {
         return false;
     }
@@ -213,10 +235,24 @@ bool Board::ChangeJoker(PlayerType p_type, int x, int y, PieceType new_type) {
     return true;
 }
 
+/**
+ * @brief Fills a buffer with the printed board (same as operator<<), each row is followed by a new line.
+ * 
+ * @param grid A buffer of GetGridSize() chars
+ */
+void Board::FillGrid(char* grid) const {
+    for (int i=0; i<_n; ++i) {
+        for (int j=0; j<_m; ++j) {
+            *grid++ = At(i, j).ToChar();
+        }
+        *grid++ = '\n';
+    }
+}
+
 ostream& operator<<(ostream& output, const Board& b) {
     for (int i=0; i<b._n; ++i) {
         for (int j=0; j<b._m;++j) {
-            output  << b._board[i][j];
+            output  << b.At(i, j);
         }
         output << endl;
     }
@@ -250,7 +286,7 @@ void Board::PrettyPrint() {
         cout << i+1 << "\t";
         for (int j=0; j<_m;++j) {
             if (j%2 == 1) cout << " ";
-            cout << "[" << _board[i][j] << "]";
+            cout << "[" << At(i, j) << "]";
             if (j%2 == 1) cout << " ";
         }
         cout << endl;
@@ -18,13 +18,17 @@ using namespace std;
 
 class Board {
     private:
-        int _n;
-        int _m;
-        Piece** _board = nullptr;
+        int _n = 0;
+        int _m = 0;
+        Piece* _board = nullptr; // the cells in a single allocation, row after row (cell (x,y) is _board[x * _m + y])
+        Piece& At(int x, int y) { return _board[x * _m + y]; }
+        const Piece& At(int x, int y) const { return _board[x * _m + y]; }
+        static void MergeCell(Piece& dest, Piece& src);
     public:
         // C'tor
         Board(int n, int m);
         Board(const Board& b);
+        Board(Board&& b) noexcept;
         // D'tor
         ~Board();
         // Get
@@ -32,6 +36,7 @@ class Board {
         int GetDimentionY() { return _m; }
         // Utility
         Board& operator=(const Board& b);
+        Board& operator=(Board&& b) noexcept;
         bool IsPositionValid(int x, int y) { return (x >= 0 && x < _n) && (y >= 0 && y < _m); }
         bool IsMoveLegal(PlayerType player_type, int x, int y, int new_x, int new_y);
         bool PlacePiece(Player* owner, PieceType type, int x, int y, bool is_joker=false);
@@ -39,6 +44,9 @@ class Board {
         bool ChangeJoker(PlayerType player_type, int x, int y, PieceType new_type);
         Board& Merge(const Board& b);
         void PrettyPrint();
+        // Output: the printed board size (rows of columns + new line) and filling a buffer of that size
+        int GetGridSize() const { return _n * (_m + 1); }
+        void FillGrid(char* grid) const;
     
     friend ostream& operator<<(ostream& output, const Board& b);
 };
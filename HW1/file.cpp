@@ -4,60 +4,148 @@
 #include "board.h"
 #include "game.h"
 #include <string>
-#include <sstream>
-#include <vector>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-string& TrimLine(string& s, const string& delmiters=" \f\n\r\t\v") {
-	return s.erase(s.find_last_not_of(delmiters) + 1).erase(0, s.find_first_not_of(delmiters));	
+#define WHITESPACE " \f\n\r\t\v"
+
+bool IsWhitespace(char c) {
+	return c != '\0' && strchr(WHITESPACE, c) != nullptr;
+}
+
+bool Token::Equals(const char* str) const {
+	size_t len = strlen(str);
+	return len == Size() && memcmp(_begin, str, len) == 0;
+}
+
+Token& TrimToken(Token& t) {
+	while (t._begin < t._end && IsWhitespace(*t._begin))
+		++t._begin;
+	while (t._end > t._begin && IsWhitespace(*(t._end - 1)))
+		--t._end;
+	return t;
+}
+
+// Splits by the delimiter, skipping empty words. Stores up to max_tokens
+// trimmed words and returns the total number of words in the line.
+int SplitLine(const Token& line, const char delimiter, Token* tokens, int max_tokens) {
+	int count = 0;
+	const char* curr = line._begin;
+	Token word;
+	while (curr < line._end) {
+		word._begin = curr;
+		while (curr < line._end && *curr != delimiter)
+			++curr;
+		word._end = curr;
+		if (word.Size() > 0) {
+			if (count < max_tokens)
+				tokens[count] = TrimToken(word);
+			++count;
+		}
+		++curr;
+	}
+	return count;
+}
+
+// Parses an int from the start of the token (like stoi), false if there
+// are no digits or the number is out of range
+bool ParseInt(const Token& t, int& value) {
+	const char* curr = t._begin;
+	bool negative = false;
+	long long result = 0;
+	if (curr < t._end && (*curr == '-' || *curr == '+')) {
+		negative = *curr == '-';
+		++curr;
+	}
+	if (curr == t._end || *curr < '0' || *curr > '9') {
+		return false;
+	}
+	for (; curr < t._end && *curr >= '0' && *curr <= '9'; ++curr) {
+		result = result * 10 + (*curr - '0');
+		if (result > (long long)INT_MAX + 1) {
+			return false;
+		}
+	}
+	if (negative)
+		result = -result;
+	if (result > INT_MAX || result < INT_MIN) {
+		return false;
+	}
+	value = int(result);
+	return true;
 }
 
-vector<string> SplitLine(const string& s, const char delimiter) {
-	vector<string> result;
-	stringstream ss(s);
-	string word;
-	while (getline(ss, word, delimiter)) {
-		if (word.size() > 0)
-			result.push_back(TrimLine(word));
+FileHandler::~FileHandler() {
+	if (_mapping != nullptr) {
+		munmap(_mapping, _mapping_size);
 	}
-	return result;
 }
 
 Reason FileHandler::InitializeFile() { 
-	try {
-		_f.open(_file_path); 
+	struct stat st;
+	int fd = open(_file_path, O_RDONLY);
+	if (fd < 0) {
+		return Reason::UNKNOWN_ERROR;
 	}
-	catch (...) {
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		close(fd);
 		return Reason::UNKNOWN_ERROR;
 	}
-	string line;
-	if (_f.is_open()) {
-		while (!_f.eof()) {
-			getline(_f, line);
-			if (TrimLine(line).size() > 0) {
-				_f.seekg(0, ios::beg);
-				_current_line = 0;
-				return Reason::SUCCESS;
-			}
+	if (st.st_size > 0) {
+		_mapping_size = size_t(st.st_size);
+		_mapping = mmap(nullptr, _mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (_mapping == MAP_FAILED) {
+			_mapping = nullptr;
+			close(fd);
+			return Reason::UNKNOWN_ERROR;
+		}
+		_cursor = static_cast<const char*>(_mapping);
+		_end = _cursor + _mapping_size;
+	}
+	// the mapping stays valid after closing the descriptor
+	close(fd);
+
+	Token line;
+	while (!_eof) {
+		ReadRawLine(line);
+		if (TrimToken(line).Size() > 0) {
+			// rewind to the start of the file
+			_cursor = static_cast<const char*>(_mapping);
+			_eof = false;
+			_current_line = 0;
+			return Reason::SUCCESS;
 		}
-	} else {
-		return Reason::UNKNOWN_ERROR;
 	}
 	return Reason::FILE_ERROR;
 }
 
-Reason FileHandler::ReadLine(string& line) {
-	try {
-		if (!_f.eof()) {
-			do {
-				getline(_f, line);
-				line = TrimLine(line);
-				++_current_line;
-			} while (line.size() <= 0 && !_f.eof());
-		}
-	} catch (...) {
-		return Reason::UNKNOWN_ERROR;
+// Reads a line like getline does, reaching EOF if the line isn't terminated
+void FileHandler::ReadRawLine(Token& line) {
+	const char* nl = _cursor == _end ? nullptr : static_cast<const char*>(memchr(_cursor, '\n', size_t(_end - _cursor)));
+	line._begin = _cursor;
+	if (nl == nullptr) {
+		line._end = _end;
+		_cursor = _end;
+		_eof = true;
+	} else {
+		line._end = nl;
+		_cursor = nl + 1;
+	}
+}
+
+Reason FileHandler::ReadLine(Token& line) {
+	line = Token();
+	while (!_eof) {
+		ReadRawLine(line);
+		++_current_line;
+		if (TrimToken(line).Size() > 0)
+			break;
 	}
 	return Reason::SUCCESS;
 }
@@ -71,40 +159,41 @@ Reason PositionFile::ParseFile(Player* player) {
 	bool is_joker;
 	int x, y;
 
-	string line;
+	Token line;
+	Token s_line[MAX_TOKENS];
+	int num_tokens;
 	
 	while(!IsEOF()) {
 		is_joker = false;
 		if (ReadLine(line) != Reason::SUCCESS ) {
 			return Reason::UNKNOWN_ERROR;
 		}
-		vector<string> s_line = SplitLine(line, delim);
-		if (s_line.size() == 0) {
+		num_tokens = SplitLine(line, delim, s_line, MAX_TOKENS);
+		if (num_tokens == 0) {
 			// empty line, continues
 			continue;
 		}
-		if (s_line.size() < 3) {
+		if (num_tokens < 3) {
 			return Reason::LINE_ERROR;
 		}
-		piece_type = CharToPieceType(s_line[0][0]);
-		if (s_line[0].size() != 1 || piece_type == PieceType::NONE) {
+		piece_type = CharToPieceType(s_line[0].First());
+		if (s_line[0].Size() != 1 || piece_type == PieceType::NONE) {
 			return Reason::LINE_ERROR;
 		}
-		try {
-			x = stoi(s_line[2]) - 1;
-			y = stoi(s_line[1]) - 1;
-		} catch (...) {
+		if (!ParseInt(s_line[2], x) || !ParseInt(s_line[1], y)) {
 			// number conversion error
 			return Reason::LINE_ERROR;
 		}
+		--x;
+		--y;
 		--piece_count[int(piece_type)];
 		if (piece_type == PieceType::JOKER){
 			// joker piece
 			is_joker = true;
-			if (s_line.size() != 4 || s_line[3].size() != 1) {
+			if (num_tokens != 4 || s_line[3].Size() != 1) {
 				return Reason::LINE_ERROR;
 			}
-			piece_type = CharToPieceType(s_line[3][0]);
+			piece_type = CharToPieceType(s_line[3].First());
 		}
 		if (piece_count[int(piece_type)] < 0) {
 			return Reason::LINE_ERROR;
@@ -123,7 +212,9 @@ Reason MoveFile::NextMove(Player* player) {
 	// get a move from the file and parse it
 	const char delim = ' ';
 	const char* joker_str = "J:";
-	string line;
+	Token line;
+	Token s_line[MAX_TOKENS];
+	int num_tokens;
 	int from_x, from_y, to_x, to_y;
 	bool is_j_change = false;
 	int joker_x, joker_y;
@@ -132,40 +223,34 @@ Reason MoveFile::NextMove(Player* player) {
 	if (ReadLine(line) == Reason::UNKNOWN_ERROR) {
 		return Reason::UNKNOWN_ERROR;
 	}
-	vector<string> s_line = SplitLine(line, delim);
+	num_tokens = SplitLine(line, delim, s_line, MAX_TOKENS);
 
-	if (s_line.size() == 0) return Reason::SUCCESS;
+	if (num_tokens == 0) return Reason::SUCCESS;
 
-	if (s_line.size() < 4) {
+	if (num_tokens < 4) {
 		return Reason::LINE_ERROR;
 	}
-	if (s_line.size() >= 8) {
-		if (s_line[4].compare(joker_str) != 0) {
+	if (num_tokens >= 8) {
+		if (!s_line[4].Equals(joker_str)) {
 			return Reason::LINE_ERROR;
 		}
 		is_j_change = true;
 	}
-	try {
-		from_x = stoi(s_line[1]) - 1;
-		from_y = stoi(s_line[0]) - 1;
-		to_x = stoi(s_line[3]) - 1;
-		to_y = stoi(s_line[2]) - 1;
-	} catch (...) {
+	if (!ParseInt(s_line[1], from_x) || !ParseInt(s_line[0], from_y) || !ParseInt(s_line[3], to_x) || !ParseInt(s_line[2], to_y)) {
 		// number conversion error
 		return Reason::LINE_ERROR;
 	}
+	--from_x; --from_y; --to_x; --to_y;
 	if (is_j_change) {
-		if (s_line.size() != 8 || s_line[7].size() != 1) {
+		if (num_tokens != 8 || s_line[7].Size() != 1) {
 			return Reason::LINE_ERROR;
 		}
-		try {
-			joker_x = stoi(s_line[6]) - 1;
-			joker_y = stoi(s_line[5]) - 1;
-		} catch (...) {
+		if (!ParseInt(s_line[6], joker_x) || !ParseInt(s_line[5], joker_y)) {
 			// number conversion error
 			return Reason::LINE_ERROR;
 		}
-		new_j_type = CharToPieceType(s_line[7][0]);
+		--joker_x; --joker_y;
+		new_j_type = CharToPieceType(s_line[7].First());
 	}
 	if (!_board->MovePiece(player->GetType(), from_x, from_y, to_x, to_y)) {
 		return Reason::LINE_ERROR;
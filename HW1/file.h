@@ -4,28 +4,49 @@
 #include "board.h"
 #include "piece.h"
 #include "game.h"
+#include <cstddef>
 #include <iostream>
-#include <fstream>
 #include <string>
 
 using namespace std;
 
+// The maximal number of words in a valid line (a move with a joker change)
+#define MAX_TOKENS 8
+
+// A view of a range of characters inside a mapped file [_begin, _end)
+struct Token {
+	const char* _begin = nullptr;
+	const char* _end = nullptr;
+	size_t Size() const { return size_t(_end - _begin); }
+	char First() const { return _begin < _end ? *_begin : '\0'; }
+	bool Equals(const char* str) const;
+};
+
 class FileHandler {
 	private:
 		const char* _file_path;
-		ifstream _f;
+		void* _mapping; // the memory mapped file (nullptr if not mapped or empty)
+		size_t _mapping_size;
+		const char* _cursor; // start of the next unread line
+		const char* _end; // end of the file data
+		bool _eof;
 		int _current_line;
+		// Utility
+		void ReadRawLine(Token& line);
 	public:
 		// C'tor
-		FileHandler(const char* f_path) : _file_path(f_path), _current_line(0) {}
+		FileHandler(const char* f_path) : _file_path(f_path), _mapping(nullptr), _mapping_size(0), _cursor(nullptr), _end(nullptr), _eof(false), _current_line(0) {}
+		// No copying of the mapping
+		FileHandler(const FileHandler&) = delete;
+		FileHandler& operator=(const FileHandler&) = delete;
 		// D'tor
-		virtual ~FileHandler() { _f.close(); }
+		virtual ~FileHandler();
 		// Get
 		int GetCurrentLineNumber() { return _current_line; }
 		// Utility
-		bool IsEOF() { return _f.eof(); }
+		bool IsEOF() { return _eof; }
 		Reason InitializeFile();
-		virtual Reason ReadLine(string& line);
+		virtual Reason ReadLine(Token& line);
 };
 
 class PositionFile : public FileHandler {
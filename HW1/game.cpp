@@ -11,10 +11,17 @@
 #include "piece.h"
 #include "player.h"
 #include "file.h"
+#include "writer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -45,44 +52,29 @@ string GenerateOutputResult(Reason p1_r, Reason p2_r, Reason g_r, const string&
             if (p1_r == Reason::LINE_ERROR) msg_reason = RSN_BAD_POSITION_FILE_DOUBLE + info;
         }
     }
-    stringstream ss;
-    ss << "Winner: " << winner << endl << "Reason: " << msg_reason << endl << endl;
-    return ss.str();
+    return "Winner: " + to_string(winner) + "\nReason: " + msg_reason + "\n\n";
 }
 
+/**
+ * @brief Formats the result and the board into one buffer and queues it to the background writer.
+ * Write errors are reported when the writer is flushed.
+ * 
+ */
 void OutputResult(const char* path, const string info, const Board& b) {
-    ofstream out;
-    try {
-		out.open(path, ios::trunc); 
-        out << info << b;
-        out.close();
-	}
-	catch (...) {
-		cout << "[ERROR] Failed to open/create output file." << endl << "Exiting..." << endl;
-	}
+    string content;
+    content.reserve(info.size() + b.GetGridSize());
+    content = info;
+    content.resize(info.size() + b.GetGridSize());
+    b.FillGrid(&content[info.size()]);
+    ResultWriter::Get().Write(path, move(content));
 }
 
-int main(int argc, char** argv) {
-    const char* outfile_path;
-    const char* p1_posfile_path;
-    const char* p2_posfile_path;
-    const char* p1_movfile_path;
-    const char* p2_movfile_path;
-
-    if (argc >= 6) {
-        outfile_path = argv[1];
-        p1_posfile_path = argv[2];
-        p2_posfile_path = argv[3];
-        p1_movfile_path = argv[4];
-        p2_movfile_path = argv[5];
-    }
-    else {
-        outfile_path = "./rps.output";
-        p1_posfile_path = "./player1.rps_board";
-        p2_posfile_path = "./player2.rps_board";
-        p1_movfile_path = "./player1.rps_moves";
-        p2_movfile_path = "./player2.rps_moves";
-    }
+/**
+ * @brief Plays a single game from the given files and writes its result.
+ * 
+ * @return int 0 if the game was played, 1 if the files couldn't be read
+ */
+int PlayGame(const char* outfile_path, const char* p1_posfile_path, const char* p2_posfile_path, const char* p1_movfile_path, const char* p2_movfile_path) {
 
     string msg_reason; // will have reason message
     Reason p1_reason, p2_reason;
@@ -223,4 +215,142 @@ int main(int argc, char** argv) {
     bool is_finished = mov_p1.IsEOF() && mov_p2.IsEOF();
     OutputResult(outfile_path, GenerateOutputResult(p1_lose,p2_lose, Reason::SUCCESS, msg_reason, is_finished), b);
     return 0;
+}
+
+/**
+ * @brief A single game of a batch manifest
+ * 
+ */
+struct BatchGame {
+    int _line;
+    string _paths[6]; // boards, moves, expected output and output
+    bool _passed;
+};
+
+bool ReadFileContent(const string& path, string& content) {
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    stringstream ss;
+    ss << in.rdbuf();
+    content = ss.str();
+    return true;
+}
+
+/**
+ * @brief Plays all the games of a manifest across a pool of threads and compares each output to the expected one.
+ * Every non empty line (not starting with '#') of the manifest is a game:
+ * <p1 board> <p2 board> <p1 moves> <p2 moves> <expected output> [<output>]
+ * Relative paths are relative to the manifest directory, the output defaults to the expected path + ".actual".
+ * 
+ * @return int 0 if all games matched the expected output, 1 otherwise
+ */
+int PlayBatch(const char* manifest_path, int num_threads) {
+    ifstream manifest(manifest_path);
+    string path(manifest_path);
+    string dir = path.find('/') == string::npos ? "" : path.substr(0, path.rfind('/') + 1);
+    vector<BatchGame> games;
+    string line;
+    int line_number = 0;
+
+    if (!manifest.is_open()) {
+        cout << "[ERROR] Can't open the manifest file." << endl;
+        return 1;
+    }
+    while (getline(manifest, line)) {
+        stringstream fields(line);
+        vector<string> words;
+        string word;
+        ++line_number;
+        while (fields >> word) {
+            words.push_back(word);
+        }
+        if (words.empty() || words[0][0] == '#') {
+            continue;
+        }
+        if (words.size() != 5 && words.size() != 6) {
+            cout << "[ERROR] Bad manifest line " << line_number << "." << endl;
+            return 1;
+        }
+        BatchGame game;
+        game._line = line_number;
+        game._passed = false;
+        for (int i = 0; i < 6; ++i) {
+            // relative to the manifest directory
+            string& curr = i < int(words.size()) ? words[i] : words[4];
+            game._paths[i] = curr[0] == '/' ? curr : dir + curr;
+        }
+        if (words.size() == 5) {
+            game._paths[5] += ".actual";
+        }
+        games.push_back(game);
+    }
+
+    atomic<int> next_game(0);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    num_threads = max(1, min(num_threads, int(games.size())));
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            while ((i = next_game++) < int(games.size())) {
+                BatchGame& game = games[i];
+                game._passed = PlayGame(game._paths[5].c_str(), game._paths[0].c_str(), game._paths[1].c_str(), game._paths[2].c_str(), game._paths[3].c_str()) == 0;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    // outputs are written in the background, compare only after all are written
+    ResultWriter::Get().Flush();
+    threads.clear();
+    next_game = 0;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            string expected, actual;
+            while ((i = next_game++) < int(games.size())) {
+                BatchGame& game = games[i];
+                game._passed = game._passed && ReadFileContent(game._paths[4], expected) && ReadFileContent(game._paths[5], actual) && expected == actual;
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+    int passed = 0;
+    for (auto& game : games) {
+        if (game._passed) {
+            ++passed;
+        } else {
+            cout << "[FAIL] line " << game._line << ": " << game._paths[5] << " doesn't match " << game._paths[4] << endl;
+        }
+    }
+    cout << "[INFO] Passed " << passed << "/" << games.size() << " games in " << elapsed.count() << "ms, using " << num_threads << " threads." << endl;
+#ifndef NDEBUG
+    cout << "[DEBUG] Created " << Piece::GetTotalCreatedPieceCounter() << " pieces." << endl;
+#endif
+    return passed == int(games.size()) ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && string(argv[1]) == "-batch") {
+        // ex1 -batch <manifest> [threads]
+        int num_threads = argc >= 4 ? atoi(argv[3]) : int(thread::hardware_concurrency());
+        return PlayBatch(argv[2], num_threads);
+    }
+    int ret;
+    if (argc >= 6) {
+        ret = PlayGame(argv[1], argv[2], argv[3], argv[4], argv[5]);
+    } else {
+        ret = PlayGame("./rps.output", "./player1.rps_board", "./player2.rps_board", "./player1.rps_moves", "./player2.rps_moves");
+    }
+    if (!ResultWriter::Get().Flush()) {
+        cout << "[ERROR] Failed to open/create output file." << endl << "Exiting..." << endl;
+    }
+    return ret;
 }
\ No newline at end of file
@@ -1,17 +1,37 @@
 
 #include "piece.h"
+#include <atomic>
 
+// the typed pieces created by the threads that ended (created, not live: pieces are never counted down)
+static atomic<long> finished_piece_counter(0);
 
-int Piece::_piece_counter = 0;
+/**
+ * @brief The pieces created by a thread. Kept per thread so games in parallel threads never share it,
+ * and added to the total once, when the thread ends.
+ * 
+ */
+struct ThreadPieceCounter {
+    int _count = 0;
+    ~ThreadPieceCounter() { finished_piece_counter += _count; }
+};
+static thread_local ThreadPieceCounter thread_piece_counter;
 
 Piece::Piece(PieceType type, bool is_joker, Player* owner) { 
     _piece_type = type; 
     _is_joker = is_joker;
     _owner = owner;
-    ++_piece_counter; 
+    ++thread_piece_counter._count; 
     _owner->IncrementPieceCount(_piece_type); 
 }
 
+int Piece::GetCreatedPieceCounter() {
+    return thread_piece_counter._count;
+}
+
+long Piece::GetTotalCreatedPieceCounter() {
+    return finished_piece_counter + thread_piece_counter._count;
+}
+
 /**
  * @brief Overloading on the lower than (<) operator. According to the rules of the game. Returns true only if the left side is lower "in strength" than the right side.
  * 
@@ -26,13 +46,17 @@ bool Piece::operator<(const Piece& p) {
     return false;
 }
 
-Piece& Piece::operator=(const Piece& p) {
-    if (this != &p) {
-        this->_is_joker = p._is_joker;
-        this->_piece_type = p._piece_type;
-        this->_owner = p._owner;
+/**
+ * @brief The printed char of the piece, upper case for player 1 and lower case otherwise.
+ * 
+ * @return char The printed char
+ */
+char Piece::ToChar() const {
+    PieceType type = _is_joker ? PieceType::JOKER : GetPieceType();
+    if (GetPlayerType() == PlayerType::PLAYER_1) {
+        return (char)toupper(PieceTypeToChar(type));
     }
-    return *this;
+    return (char)tolower(PieceTypeToChar(type));
 }
 
 /**
@@ -43,13 +67,7 @@ Piece& Piece::operator=(const Piece& p) {
  * @return ostream& The modified ostream
  */
 ostream& operator<<(ostream& output, const Piece& piece) {
-    PieceType type = piece._is_joker ? PieceType::JOKER : piece.GetPieceType();
-    if (piece.GetPlayerType() == PlayerType::PLAYER_1) {
-        output <<  (char)toupper(PieceTypeToChar(type));
-    } else {
-        output <<  (char)tolower(PieceTypeToChar(type));
-    }
-    return output;
+    return output << piece.ToChar();
 }
 
 /**
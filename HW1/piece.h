@@ -12,27 +12,26 @@ class Piece {
         bool _is_joker;
         PieceType _piece_type;
         Player* _owner;
-        static int _piece_counter; // general piece counter for debugging
     public:
-        // C'tors
-        Piece() : _is_joker(false), _piece_type(PieceType::NONE), _owner(nullptr) { ++_piece_counter; }
+        // C'tors (a piece is a plain value, copied and destroyed freely, boards copy their cells with memcpy)
+        Piece() : _is_joker(false), _piece_type(PieceType::NONE), _owner(nullptr) {}
         Piece(PieceType type, bool is_joker, Player* owner);
-		Piece(const Piece& p) { *this = p; }
-        // D'tor
-        ~Piece() { --_piece_counter; }
         // Get
         PieceType GetPieceType() const { return _piece_type; }
         PlayerType GetPlayerType() const { return _owner ? _owner->GetType() : PlayerType::NONE; }
-        static int GetPieceCounter() {return _piece_counter; }
+        // Debugging: the number of typed pieces ever created (not the live pieces, a piece has no d'tor to count its release),
+        // by the calling thread and by all the threads (the running threads only count their own)
+        static int GetCreatedPieceCounter();
+        static long GetTotalCreatedPieceCounter();
         // Set
         bool SetType(PieceType type);
         // Utility
         bool IsJoker() { return _is_joker; }
         bool IsInitiated() { return _piece_type != PieceType::NONE ? true : false; }
+        char ToChar() const;
         bool operator<(const Piece& p);
         bool operator==(const Piece& p) { if ( this->GetPieceType() == p.GetPieceType()) return true; return false; }
         bool operator>(const Piece& p) { return (*this) < p || (*this) == p ? false : true; }
-        Piece& operator=(const Piece& p);
         void NullifyPiece();
         void RemovePieceFromPlayer();
         
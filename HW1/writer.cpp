@@ -0,0 +1,78 @@
+#include "writer.h"
+#include <cstdio>
+
+using namespace std;
+
+ResultWriter::ResultWriter() : _in_progress(0), _failures(0), _stopping(false) {
+	_writer = thread(&ResultWriter::Run, this);
+}
+
+ResultWriter::~ResultWriter() {
+	{
+		lock_guard<mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_queue_event.notify_one();
+	if (_writer.joinable()) {
+		_writer.join();
+	}
+}
+
+ResultWriter& ResultWriter::Get() {
+	static ResultWriter writer;
+	return writer;
+}
+
+void ResultWriter::Write(string path, string content) {
+	{
+		lock_guard<mutex> lock(_mutex);
+		_queue.push_back({ move(path), move(content) });
+	}
+	_queue_event.notify_one();
+}
+
+bool ResultWriter::Flush() {
+	unique_lock<mutex> lock(_mutex);
+	_flush_event.wait(lock, [this] { return _queue.empty() && _in_progress == 0; });
+	bool success = _failures == 0;
+	_failures = 0;
+	return success;
+}
+
+/**
+ * @brief The writer thread. Takes the whole queue as a batch and writes it outside of the lock.
+ * 
+ */
+void ResultWriter::Run() {
+	vector<PendingWrite> batch;
+	while (true) {
+		{
+			unique_lock<mutex> lock(_mutex);
+			_queue_event.wait(lock, [this] { return _stopping || !_queue.empty(); });
+			if (_queue.empty()) {
+				break;
+			}
+			batch.swap(_queue);
+			_in_progress = int(batch.size());
+		}
+		int failures = 0;
+		for (auto& file : batch) {
+			FILE* out = fopen(file._path.c_str(), "w");
+			if (out == nullptr) {
+				++failures;
+				continue;
+			}
+			bool written = fwrite(file._content.data(), 1, file._content.size(), out) == file._content.size();
+			if (fclose(out) != 0 || !written) {
+				++failures;
+			}
+		}
+		batch.clear();
+		{
+			lock_guard<mutex> lock(_mutex);
+			_in_progress = 0;
+			_failures += failures;
+		}
+		_flush_event.notify_all();
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef _H_WRITER
+#define _H_WRITER
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Writes output files on a single background thread. Games only queue the formatted
+ * content, the writer takes all the queued files at once and writes them.
+ * 
+ */
+class ResultWriter {
+	private:
+		struct PendingWrite {
+			string _path;
+			string _content;
+		};
+		vector<PendingWrite> _queue;
+		int _in_progress; // files taken by the writer and not yet written
+		int _failures; // failed writes since the last flush
+		bool _stopping;
+		mutex _mutex;
+		condition_variable _queue_event;
+		condition_variable _flush_event;
+		thread _writer;
+		// C'tor
+		ResultWriter();
+		// Utility
+		void Run();
+	public:
+		ResultWriter(const ResultWriter&) = delete;
+		ResultWriter& operator=(const ResultWriter&) = delete;
+		// D'tor (writes whatever is queued)
+		~ResultWriter();
+		// Get (the writer of the process, started on first use)
+		static ResultWriter& Get();
+		// Utility
+		void Write(string path, string content);
+		bool Flush(); // waits for the queued files, false if a write failed
+};
+
+#endif
@@ -157,11 +157,21 @@ const AutoPlayerAlgorithm::move& AutoPlayerAlgorithm::info::peekMove() const
  * 
  * @return int - the random position on board
  */
-/*static*/ int AutoPlayerAlgorithm::getRandomPos()
+int AutoPlayerAlgorithm::getRandomPos() const
 {
     const int range_from = 0;
     const int range_to = DIM_X * DIM_Y;
-    return rand() % (range_to - range_from) + range_from;
+    return getRandom() % (range_to - range_from) + range_from;
+}
+
+/**
+ * @brief Gets the next random number of the player's generator.
+ * 
+ * @return int - a random number in [0, RAND_MAX]
+ */
+int AutoPlayerAlgorithm::getRandom() const
+{
+    return (int)(this->_random() % ((unsigned long)RAND_MAX + 1));
 }
 
 /**
@@ -203,10 +213,10 @@ const AutoPlayerAlgorithm::move& AutoPlayerAlgorithm::info::peekMove() const
  * 
  * @return char - a random Joker representation
  */
-/*static*/ char AutoPlayerAlgorithm::getRandomJokerRep()
+char AutoPlayerAlgorithm::getRandomJokerRep() const
 {
     char vTypes[] = { BOMB_CHR, ROCK_CHR, PAPER_CHR, SCISSORS_CHR };
-    int choose = rand() % 4;
+    int choose = getRandom() % 4;
     return vTypes[choose];
 }
 
@@ -445,7 +455,7 @@ bool AutoPlayerAlgorithm::willWinFight(AutoPlayerAlgorithm::info& data, int vOri
     // NOTE: assumes that origin and dest are on the board and correct pieces of two different players
     AutoPlayerAlgorithm::piece& origPiece = data._M_board[vOriginPos];
     AutoPlayerAlgorithm::piece& destPiece = data._M_board[vDestPos];
-    double chance = (double)std::rand() / (RAND_MAX);
+    double chance = (double)getRandom() / (RAND_MAX);
 
     // checks normal rules and doesn't take chances
     if ((destPiece._M_piece == origPiece._M_piece) || (destPiece._M_piece == ROCK_CHR && origPiece._M_piece == SCISSORS_CHR) || (destPiece._M_piece == SCISSORS_CHR && origPiece._M_piece == PAPER_CHR) || (destPiece._M_piece == PAPER_CHR && origPiece._M_piece == ROCK_CHR) || (destPiece._M_piece == BOMB_CHR && origPiece._M_piece != BOMB_CHR) || (destPiece._M_piece != FLAG_CHR && origPiece._M_piece == FLAG_CHR)) {
@@ -546,7 +556,7 @@ float AutoPlayerAlgorithm::calcPlayerBoardScore(AutoPlayerAlgorithm::info& data)
             avg /= (float)data._M_other_player._M_flags.size();
     } else {
         for (auto itr = data._M_other_player._M_flags.begin(); counter < flag_amount;) {
-            std::advance(itr, std::rand() % data._M_other_player._M_flags.size());
+            std::advance(itr, getRandom() % data._M_other_player._M_flags.size());
             if (itr == data._M_other_player._M_flags.end())
                 itr = data._M_other_player._M_flags.begin();
             avg += OPP_FLAG_DIST_PARAM * calcKNearestDistance(data, player, *itr, K_PROXIMITY);
@@ -699,8 +709,10 @@ void AutoPlayerAlgorithm::getInitialPositions(int player,
     this->_info._M_this_player._M_id = player;
 
     // set the seed for the randomization
-    this->_seed_value = (unsigned)time(NULL);
-    srand(this->_seed_value + player * PRIME_NUMBER);
+    if (!this->_fixed_seed) {
+        this->_seed_value = (unsigned)time(NULL);
+    }
+    this->_random.seed(this->_seed_value + player * PRIME_NUMBER);
 
     // insert flags
     positionPiecesOfType(FLAG_LIMIT, FLAG_CHR, vectorToFill);
@@ -10,7 +10,9 @@
 
 #include "GameUtilitiesRPS.h"
 #include "PlayerAlgorithm.h"
+#include <array>
 #include <memory>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -66,10 +68,22 @@ private:
 
     info _info; // will hold the current info on the thought state of the game
     unsigned _seed_value; // the random seed value
+    bool _fixed_seed; // true if the seed was given, otherwise the time is used
+    mutable std::minstd_rand _random; // the random generator of the player (never shared, players may play in parallel)
 
 public:
-    // basic c'tor
-    AutoPlayerAlgorithm() {}
+    // basic c'tor, seeded by the time when the game starts
+    AutoPlayerAlgorithm()
+        : _seed_value(0)
+        , _fixed_seed(false)
+    {
+    }
+    // c'tor with a given seed, the same seed (and opponent) plays the same game
+    explicit AutoPlayerAlgorithm(unsigned seed)
+        : _seed_value(seed)
+        , _fixed_seed(true)
+    {
+    }
     // no need for copy c'tor
     AutoPlayerAlgorithm(const AutoPlayerAlgorithm& other) = delete;
 
@@ -133,9 +147,11 @@ private:
     // get the unified position parameter
     static int getPos(int vX, int vY);
     // get a random possible joker representation
-    static char getRandomJokerRep();
+    char getRandomJokerRep() const;
     // get a random position on the board by the boarrd dimensions
-    static int getRandomPos();
+    int getRandomPos() const;
+    // get a random number in [0, RAND_MAX]
+    int getRandom() const;
     // checks if the position is valid
     static bool isPosValid(int x, int y);
     // checks if the position and move is valid (location wise)
@@ -0,0 +1,186 @@
+/**
+ * @brief The batch replay of file-vs-file games from a manifest.
+ *
+ * @file BatchReplay.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-24
+ */
+#include "BatchReplay.h"
+#include "GameManagerRPS.h"
+#include "GameUtilitiesRPS.h"
+#include "ResultWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// the suffix of the output path when not given in the manifest
+#define ACTUAL_OUTPUT_SUFFIX ".actual"
+
+/**
+ * @brief A single game of the manifest.
+ *
+ */
+struct BatchGame {
+    int _M_line; // the line in the manifest
+    std::string _M_p1_board;
+    std::string _M_p2_board;
+    std::string _M_p1_moves;
+    std::string _M_p2_moves;
+    std::string _M_expected;
+    std::string _M_output;
+    bool _M_passed = false;
+};
+
+/**
+ * @brief Resolves a path given in the manifest, relative paths are relative to the manifest directory.
+ *
+ * @param dir - the manifest directory (empty, or ending with '/')
+ * @param path - the path as written in the manifest
+ * @return std::string - the resolved path
+ */
+static std::string resolvePath(const std::string& dir, const std::string& path)
+{
+    return path.empty() || path[0] == '/' ? path : dir + path;
+}
+
+/**
+ * @brief Reads the whole content of a file.
+ *
+ * @param path - the path of the file
+ * @param rContent - filled with the content
+ * @return true - if the file was read
+ * @return false - otherwise
+ */
+static bool readFile(const std::string& path, std::string& rContent)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+
+    if (!in.is_open()) {
+        return false;
+    }
+    ss << in.rdbuf();
+    rContent = ss.str();
+    return true;
+}
+
+/**
+ * @brief Reads the games from the manifest.
+ *
+ * @param manifestPath - the path of the manifest
+ * @param rGames - filled with the games
+ * @return true - if the manifest was read and all of its lines are valid
+ * @return false - otherwise
+ */
+static bool readManifest(const char* manifestPath, std::vector<BatchGame>& rGames)
+{
+    std::ifstream manifest(manifestPath);
+    std::string path(manifestPath);
+    std::string dir = path.find('/') == std::string::npos ? "" : path.substr(0, path.rfind('/') + 1);
+    std::string line;
+    int lineNumber = 0;
+
+    if (!manifest.is_open()) {
+        std::cout << ERROR << " Can't open the manifest file '" << manifestPath << "'." << std::endl;
+        return false;
+    }
+    while (std::getline(manifest, line)) {
+        std::istringstream fields(line);
+        std::vector<std::string> words;
+        std::string word;
+        ++lineNumber;
+        while (fields >> word) {
+            words.push_back(word);
+        }
+        if (words.empty() || words[0][0] == '#') {
+            continue;
+        }
+        if (words.size() != 5 && words.size() != 6) {
+            std::cout << ERROR << " Bad manifest line " << lineNumber << ", expected: <player1 board> <player2 board> <player1 moves> <player2 moves> <expected output> [<output>]" << std::endl;
+            return false;
+        }
+        BatchGame game;
+        game._M_line = lineNumber;
+        game._M_p1_board = resolvePath(dir, words[0]);
+        game._M_p2_board = resolvePath(dir, words[1]);
+        game._M_p1_moves = resolvePath(dir, words[2]);
+        game._M_p2_moves = resolvePath(dir, words[3]);
+        game._M_expected = resolvePath(dir, words[4]);
+        game._M_output = words.size() == 6 ? resolvePath(dir, words[5]) : game._M_expected + ACTUAL_OUTPUT_SUFFIX;
+        rGames.push_back(game);
+    }
+    return true;
+}
+
+/**
+ * @brief Compares the output of a played game to the expected one.
+ *
+ * @param rGame - the played game, updated with the result
+ */
+static void checkGame(BatchGame& rGame)
+{
+    std::string expected, actual;
+
+    rGame._M_passed = readFile(rGame._M_expected, expected) && readFile(rGame._M_output, actual) && expected == actual;
+}
+
+int PlayBatchRPS(const char* manifestPath, int numOfThreads)
+{
+    std::vector<BatchGame> games;
+    std::vector<std::thread> threads;
+    std::atomic<int> nextGame(0);
+    int passed = 0;
+
+    if (!readManifest(manifestPath, games)) {
+        return 1;
+    }
+    numOfThreads = std::max(1, std::min(numOfThreads, (int)games.size()));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            while ((i = nextGame++) < (int)games.size()) {
+                PlayRPS(FILE_VS_FILE, games[i]._M_output.c_str(), games[i]._M_p1_board.c_str(), games[i]._M_p2_board.c_str(), games[i]._M_p1_moves.c_str(), games[i]._M_p2_moves.c_str());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // the outputs are written in the background, wait for all of them before comparing
+    ResultWriter::get().flush();
+    threads.clear();
+    nextGame = 0;
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            while ((i = nextGame++) < (int)games.size()) {
+                checkGame(games[i]);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    // summary, failures in manifest order
+    for (auto& game : games) {
+        if (game._M_passed) {
+            ++passed;
+            continue;
+        }
+        std::cout << "[FAIL] line " << game._M_line << ": '" << game._M_output << "' doesn't match '" << game._M_expected << "'" << std::endl;
+    }
+    std::cout << INFO << " Passed " << passed << "/" << games.size() << " games (" << games.size() - passed << " failed) in "
+              << elapsed.count() << "ms, using " << numOfThreads << " threads." << std::endl;
+    return passed == (int)games.size() ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+/**
+ * @brief The batch replay header file.
+ *
+ * @file BatchReplay.h
+ * @author Yotam Sechayk
+ * @date 2018-05-24
+ */
+#ifndef __H_BATCH_REPLAY
+#define __H_BATCH_REPLAY
+
+/**
+ * @brief Plays all the file-vs-file games listed in a manifest, in parallel, and compares each output to the expected one.
+ * Every non empty line of the manifest (lines starting with '#' are ignored) is a game:
+ * <player1 board> <player2 board> <player1 moves> <player2 moves> <expected output> [<output>]
+ * Relative paths are relative to the manifest directory, the output defaults to the expected output path with ".actual" appended.
+ *
+ * @param manifestPath The path of the manifest file
+ * @param numOfThreads The number of threads playing the games
+ * @return int - 0 if all the games matched the expected output, otherwise - 1
+ */
+int PlayBatchRPS(const char* manifestPath, int numOfThreads);
+
+#endif // !__H_BATCH_REPLAY
@@ -249,6 +249,21 @@ int BoardRPS::getPlayer(const Point& pos) const
     return NO_PLAYER;
 }
 
+/**
+ * @brief Fills a buffer with the printed board, each row is followed by a new line.
+ * 
+ * @param grid - the buffer to fill, of getGridSize() chars
+ */
+void BoardRPS::fillGrid(char* grid) const
+{
+    for (int y = 0; y < _n; ++y) {
+        for (int x = 0; x < _m; ++x) {
+            *grid++ = _board[p(x, y)] == nullptr ? ' ' : _board[p(x, y)]->toChar();
+        }
+        *grid++ = '\n';
+    }
+}
+
 /**
  * @brief The print operator implementation. A friend function. Prints a board.
  * 
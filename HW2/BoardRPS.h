@@ -67,6 +67,10 @@ public:
     bool changeJoker(int player, const std::unique_ptr<JokerChange>& rpJokerChange);
     // print the board nicely
     void prettyPrint();
+    // the size of the printed board (rows of columns + new line)
+    int getGridSize() const { return _n * (_m + 1); }
+    // fills a buffer of getGridSize() chars with the printed board (same as operator<<)
+    void fillGrid(char* grid) const;
 
     // interface defined functions
     // get the player number (id/type) of the piece in the position
@@ -12,26 +12,27 @@
 #include "GameUtilitiesRPS.h"
 #include "JokerChangeRPS.h"
 #include "MoveRPS.h"
+#include "MoveScript.h"
 #include "PlayerAlgorithm.h"
-#include <fstream>
 
 #include <string>
 
 /**
  * @brief a class implementing the PlayerAlgorithm abstract class, handles the file player of the game RPS 
+ * The whole input is parsed (or loaded from a pre-parsed script) on construction, so no I/O is done during the game.
  * 
  */
 class FilePlayerAlgorithm : public PlayerAlgorithm {
 private:
     const char* _posFilePath; //positins' file path
     const char* _moveFilePath; // moves' file path
-    std::ifstream _f_pos; //ifstream to open and handle positions' file
-    std::ifstream _f_move; //ifstream to open and handle moves' file
+    MoveScript _script; // the pre-parsed positions and moves
+    int _nextMove; // the index of the next move in the script
     std::unique_ptr<JokerChange> _jokerChange; // will hold the "current" joker move
 
 public:
-    // basic c'tor
-    FilePlayerAlgorithm(const char* positionFilePath, const char* moveFilePath);
+    // basic c'tor (uses the script file instead of the text files if given and valid)
+    FilePlayerAlgorithm(const char* positionFilePath, const char* moveFilePath, const char* scriptFilePath = nullptr);
 
     // d'tor
     ~FilePlayerAlgorithm();
@@ -49,20 +50,6 @@ public:
     std::unique_ptr<Move> getMove();
     // gets the current joker change if one was accompaneeing the last retrieved move
     std::unique_ptr<JokerChange> getJokerChange();
-
-private:
-    // parse the positions file and updates the positions vector
-    bool parsePositions(int player, std::vector<std::unique_ptr<PiecePosition>>& vectorToFill);
-    // parse the next move from the moves files
-    bool parseMove(std::unique_ptr<Move>& rpMove);
-    // initializes a file stream from file path
-    static bool initializeFile(std::ifstream& _f, const char* filePath);
-    // reads the next line in a given file stream
-    static bool readLine(std::ifstream& _f, std::string& line);
-    // trims a given string line
-    static std::string& trimLine(std::string& s, const std::string& delmiters = " \f\n\r\t\v");
-    // splits the line into a vector of string by the delimiter
-    static std::vector<std::string> splitLine(const std::string& s, const char delimiter);
 };
 
 #endif // !__H_FILE_PLAYER_ALGORITHM
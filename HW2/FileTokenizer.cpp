@@ -0,0 +1,245 @@
+/**
+ * @brief The implementation file of the FileTokenizer class.
+ *
+ * @file FileTokenizer.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-20
+ */
+#include "FileTokenizer.h"
+
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// the characters trimmed from lines and words
+#define WHITESPACE_CHARS " \f\n\r\t\v"
+
+/**
+ * @brief Checks if a character is one of the trimmed whitespace characters.
+ *
+ */
+static inline bool isWhitespace(char c)
+{
+    return c != '\0' && std::strchr(WHITESPACE_CHARS, c) != nullptr;
+}
+
+/**
+ * @brief Compares the token to a null terminated string.
+ *
+ * @param str - the string to compare to
+ * @return true - iff the token has exactly the characters of the string
+ * @return false - otherwise
+ */
+bool FileTokenizer::token::equals(const char* str) const
+{
+    std::size_t len = std::strlen(str);
+    return len == size() && std::memcmp(_M_begin, str, len) == 0;
+}
+
+FileTokenizer::FileTokenizer()
+    : _mapping(nullptr)
+    , _mappingSize(0)
+    , _cursor(nullptr)
+    , _end(nullptr)
+    , _isOpen(false)
+    , _eof(false)
+{
+}
+
+FileTokenizer::~FileTokenizer()
+{
+    close();
+}
+
+/**
+ * @brief Opens a file and maps it into memory. An empty file is opened with no mapping.
+ *
+ * @param filePath - the path of the file
+ * @return true - if the file was opened successfully
+ * @return false - otherwise
+ */
+bool FileTokenizer::open(const char* filePath)
+{
+    struct stat st;
+    int fd;
+
+    close();
+    fd = ::open(filePath, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size > 0) {
+        _mappingSize = (std::size_t)st.st_size;
+        _mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (_mapping == MAP_FAILED) {
+            _mapping = nullptr;
+            _mappingSize = 0;
+            ::close(fd);
+            return false;
+        }
+        // the file is read once, from start to end
+        madvise(_mapping, _mappingSize, MADV_SEQUENTIAL);
+        _cursor = static_cast<const char*>(_mapping);
+        _end = _cursor + _mappingSize;
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    _isOpen = true;
+    return true;
+}
+
+/**
+ * @brief Unmaps the file and resets the tokenizer.
+ *
+ */
+void FileTokenizer::close()
+{
+    if (_mapping != nullptr) {
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _cursor = nullptr;
+    _end = nullptr;
+    _isOpen = false;
+    _eof = false;
+}
+
+/**
+ * @brief Reads the next line up to (not including) the new line character.
+ * As in std::getline, eof is reached when the line isn't terminated by a new line.
+ *
+ * @param line - filled with the read line
+ */
+void FileTokenizer::readRawLine(token& line)
+{
+    const char* nl = _cursor == _end ? nullptr : static_cast<const char*>(std::memchr(_cursor, '\n', (std::size_t)(_end - _cursor)));
+
+    line._M_begin = _cursor;
+    if (nl == nullptr) {
+        line._M_end = _end;
+        _cursor = _end;
+        _eof = true;
+    } else {
+        line._M_end = nl;
+        _cursor = nl + 1;
+    }
+}
+
+/**
+ * @brief Trims the token from the whitespace characters at both ends.
+ *
+ * @param t - the token to trim
+ * @return FileTokenizer::token& - the token reference for continued work
+ */
+/*static*/ FileTokenizer::token& FileTokenizer::trimToken(token& t)
+{
+    while (t._M_begin < t._M_end && isWhitespace(*t._M_begin)) {
+        ++t._M_begin;
+    }
+    while (t._M_end > t._M_begin && isWhitespace(*(t._M_end - 1))) {
+        --t._M_end;
+    }
+    return t;
+}
+
+/**
+ * @brief Reads the next non empty line, trimmed. Empty lines are skipped until the end of the file.
+ *
+ * @param line - filled with the read line (empty if there are no more lines)
+ * @return true - if the file is open
+ * @return false - otherwise
+ */
+bool FileTokenizer::readLine(token& line)
+{
+    line = token();
+    if (!_isOpen) {
+        return false;
+    }
+    while (!_eof) {
+        readRawLine(line);
+        if (trimToken(line).size() > 0) {
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Splits a line by the delimiter, empty words are skipped and the rest are trimmed.
+ * Only the first maxTokens words are stored, but all are counted.
+ *
+ * @param line - the line to split
+ * @param delimiter - the delimiter between words
+ * @param tokens - the array of words to fill
+ * @param maxTokens - the size of the array
+ * @return int - the total number of words in the line
+ */
+/*static*/ int FileTokenizer::splitLine(const token& line, const char delimiter, token* tokens, int maxTokens)
+{
+    int count = 0;
+    const char* curr = line._M_begin;
+    token word;
+
+    while (curr < line._M_end) {
+        word._M_begin = curr;
+        while (curr < line._M_end && *curr != delimiter) {
+            ++curr;
+        }
+        word._M_end = curr;
+        if (word.size() > 0) {
+            if (count < maxTokens) {
+                tokens[count] = trimToken(word);
+            }
+            ++count;
+        }
+        // skip the delimiter
+        ++curr;
+    }
+    return count;
+}
+
+/**
+ * @brief Parses an integer from the start of the token, stops on the first non digit character.
+ *
+ * @param t - the token to parse
+ * @param value - filled with the parsed number
+ * @return true - if a number was parsed
+ * @return false - if there are no digits or the number doesn't fit in an int
+ */
+/*static*/ bool FileTokenizer::parseInt(const token& t, int& value)
+{
+    const char* curr = t._M_begin;
+    bool negative = false;
+    long long result = 0;
+    const long long limit = (long long)INT_MAX + 1;
+
+    if (curr < t._M_end && (*curr == '-' || *curr == '+')) {
+        negative = *curr == '-';
+        ++curr;
+    }
+    if (curr == t._M_end || *curr < '0' || *curr > '9') {
+        return false;
+    }
+    for (; curr < t._M_end && *curr >= '0' && *curr <= '9'; ++curr) {
+        result = result * 10 + (*curr - '0');
+        if (result > limit) {
+            return false;
+        }
+    }
+    if (negative) {
+        result = -result;
+    }
+    if (result > INT_MAX || result < INT_MIN) {
+        return false;
+    }
+    value = (int)result;
+    return true;
+}
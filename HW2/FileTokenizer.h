@@ -0,0 +1,76 @@
+/**
+ * @brief The header file of the FileTokenizer class.
+ *
+ * @file FileTokenizer.h
+ * @author Yotam Sechayk
+ * @date 2018-05-20
+ */
+#ifndef __H_FILE_TOKENIZER
+#define __H_FILE_TOKENIZER
+
+#include <cstddef>
+
+/**
+ * @brief A read-only tokenizer over a memory mapped input file.
+ * Lines and words are handed out as views into the mapping, so no allocation is made while parsing.
+ * Reading lines has the same semantics as std::getline followed by trimming (including when eof is reached).
+ *
+ */
+class FileTokenizer {
+public:
+    // a view of a range of characters inside the mapping [_M_begin, _M_end)
+    struct token {
+        const char* _M_begin = nullptr;
+        const char* _M_end = nullptr;
+
+        // the number of characters in the token
+        std::size_t size() const { return (std::size_t)(_M_end - _M_begin); }
+        // the first character of the token ('\0' if empty)
+        char first() const { return _M_begin < _M_end ? *_M_begin : '\0'; }
+        // true iff the token is equal to the given null terminated string
+        bool equals(const char* str) const;
+    };
+
+private:
+    void* _mapping; // the memory mapped file (nullptr if not mapped or empty)
+    std::size_t _mappingSize; // the size of the mapped region
+    const char* _cursor; // the start of the next unread line
+    const char* _end; // the end of the file data
+    bool _isOpen; // true iff the file was opened
+    bool _eof; // true iff the last read line reached the end of the file
+
+public:
+    // basic c'tor
+    FileTokenizer();
+    // no need for copy c'tor
+    FileTokenizer(const FileTokenizer& other) = delete;
+    // d'tor
+    ~FileTokenizer();
+
+    // no need for copy assignment
+    FileTokenizer& operator=(const FileTokenizer& other) = delete;
+
+    // maps the file into memory, false if the file couldn't be opened
+    bool open(const char* filePath);
+    // unmaps the file
+    void close();
+    // true iff the file was opened
+    bool isOpen() const { return _isOpen; }
+    // true iff the end of the file was reached
+    bool eof() const { return _eof; }
+    // reads the next non empty line (trimmed), an empty line is given when the end of the file is reached
+    bool readLine(token& line);
+
+    // splits a line by the delimiter into (at most maxTokens) trimmed words, returns the total number of words
+    static int splitLine(const token& line, const char delimiter, token* tokens, int maxTokens);
+    // parses a base 10 integer from the start of the token (same as stoi), false if no number or out of range
+    static bool parseInt(const token& t, int& value);
+
+private:
+    // reads the next line, as is (std::getline semantics)
+    void readRawLine(token& line);
+    // trims a token from the whitespace characters at both ends
+    static token& trimToken(token& t);
+};
+
+#endif // !__H_FILE_TOKENIZER
@@ -5,11 +5,14 @@
  * @author Yotam Sechayk
  * @date 2018-04-27
  */
+#include "BatchReplay.h"
 #include "GameManagerRPS.h"
 #include "GameUtilitiesRPS.h"
+#include "ResultWriter.h"
 
 #include <iostream>
 #include <string>
+#include <thread>
 
 // Prints a message to the screen with the desired label type
 void printMessageToScreen(const std::string&& rrType, const std::string&& rrMsg, const std::string&& rrInfo = "")
@@ -24,7 +27,12 @@ int main(int argc, char** argv)
     const std::string fvf = "file-vs-file";
     const std::string avf = "auto-vs-file";
     const std::string fva = "file-vs-auto";
+    const std::string batch = "batch";
+    const std::string sweep = "sweep";
     int gameResult;
+    int gameStyle;
+    int numOfGames;
+    int numOfThreads;
 
     if (argc < 2) {
         printMessageToScreen(ERROR, "No play type was entered.", BAD_ARGS_MESSAGE);
@@ -33,6 +41,54 @@ int main(int argc, char** argv)
 
     printMessageToScreen(INFO, argv[1]);
 
+    if (!batch.compare(argv[1])) {
+        // batch <manifest> [threads]
+        if (argc < 3) {
+            printMessageToScreen(ERROR, "No manifest file was entered.", BAD_ARGS_MESSAGE);
+            return 1;
+        }
+        numOfThreads = std::thread::hardware_concurrency();
+        if (argc >= 4) {
+            try {
+                numOfThreads = std::stoi(argv[3]);
+            } catch (...) {
+                numOfThreads = 0;
+            }
+        }
+        if (numOfThreads <= 0) {
+            printMessageToScreen(ERROR, "The number of threads was not entered correctly.", BAD_ARGS_MESSAGE);
+            return 1;
+        }
+        return PlayBatchRPS(argv[2], numOfThreads);
+    }
+
+    if (!sweep.compare(argv[1])) {
+        // sweep <play type> <games> [threads] [output dir]
+        if (argc < 4) {
+            printMessageToScreen(ERROR, "No play type or number of games was entered.", BAD_ARGS_MESSAGE);
+            return 1;
+        }
+        gameStyle = !ava.compare(argv[2]) ? AUTO_VS_AUTO : !fvf.compare(argv[2]) ? FILE_VS_FILE : !avf.compare(argv[2]) ? AUTO_VS_FILE : !fva.compare(argv[2]) ? FILE_VS_AUTO : 0;
+        numOfThreads = std::thread::hardware_concurrency();
+        try {
+            numOfGames = std::stoi(argv[3]);
+            if (argc >= 5) {
+                numOfThreads = std::stoi(argv[4]);
+            }
+        } catch (...) {
+            numOfGames = 0;
+        }
+        if (gameStyle == 0 || numOfGames <= 0 || numOfThreads <= 0) {
+            printMessageToScreen(ERROR, "The play type, number of games or number of threads was not entered correctly.", BAD_ARGS_MESSAGE);
+            return 1;
+        }
+        gameResult = PlaySweepRPS(gameStyle, numOfGames, numOfThreads, argc >= 6 ? argv[5] : nullptr);
+        if (!ResultWriter::get().flush()) {
+            gameResult = 1;
+        }
+        return gameResult;
+    }
+
     if (!ava.compare(argv[1])) {
         gameResult = PlayRPS(AUTO_VS_AUTO);
     } else if (!fvf.compare(argv[1])) {
@@ -46,6 +102,10 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // wait for the output file to be written
+    if (!ResultWriter::get().flush()) {
+        gameResult = 1;
+    }
     if (gameResult != 0) {
         printMessageToScreen(ERROR, "Failed to open/create output file.");
         return 1;
@@ -6,224 +6,110 @@
  * @date 2018-05-04
  */
 #include "GameManagerRPS.h"
-#include "AutoPlayerAlgorithm.h"
-#include "BoardRPS.h"
-#include "FilePlayerAlgorithm.h"
-#include "MoveRPS.h"
-#include "PieceRPS.h"
-#include "PointRPS.h"
-#include "ScoreManager.h"
+#include "GameSessionRPS.h"
 
-#include <cassert>
-#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
 #include <map>
-#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
- * @brief : Fills output file with game results, describing:
- * 1.winner 2.reason of winning 3.state of the board after the game is over
- * 
- * @param path - path of the output file to be filled
- * @param b - the board at the final state
- * @param winner - winner of the game
- * @param msg_reason - reason of winning as specified in the homework guidelines
- * @return int - 0 if there was an error filling the output file, and 1 otherwise
+ * @brief Tells if a player of a game style is an automatic player or a file player.
+ *
+ * @param vGameStyle An integer {1: auto-vs-auto, 2: file-vs-file, 3: auto-vs-file, 4: file-vs-auto}
+ * @param player - the player number
+ * @param isAuto - set to true if the player is an automatic player
+ * @return bool - false if the game style isn't valid
  */
-int outputGameResult(const char* path, const BoardRPS& b, int winner, std::string msg_reason)
+static bool isAutoPlayer(int vGameStyle, int player, bool& isAuto)
 {
-    std::ofstream out;
-    try {
-        out.open(path, std::ios::trunc);
-        out << "Winner: " << winner << std::endl
-            << "Reason: " << msg_reason << std::endl
-            << std::endl
-            << b;
-        out.close();
-    } catch (...) {
-        return 1;
+    switch (vGameStyle) {
+    case AUTO_VS_AUTO:
+        isAuto = true;
+        return true;
+    case FILE_VS_FILE:
+        isAuto = false;
+        return true;
+    case AUTO_VS_FILE:
+        isAuto = player == PLAYER_1;
+        return true;
+    case FILE_VS_AUTO:
+        isAuto = player == PLAYER_2;
+        return true;
     }
-    return 0;
+    return false;
 }
 
-/**
- * @brief - Asks for next move of current player and performs the move by calling BoardRPS member function
- * if the move was not legal then it notifies the ScoreManager of current player as loser
- * if the move was legal: 1. it notifies both player of the fight result, in case there was a fight
- * 2. it notifies opponent player of the current move
- * 3. in case there was a joker change, notifies the ScoreManager of it.
- * 
- * @param currPlayerNumber - current player number which this is his turn
- * @param rpCurrPlayer - reference to current player which this is his turn
- * @param rpOppPlayer - reference to opponent player(which this is not his turn)
- * @param myBoard - game board reference
- * @param rScoreManager - ScoreManager reference
- */
-void playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgorithm>& rpCurrPlayer, std::unique_ptr<PlayerAlgorithm>& rpOppPlayer, BoardRPS& myBoard, ScoreManager& rScoreManager)
+int PlayRPS(int vGameStyle)
 {
-    std::unique_ptr<FightInfo> fightInfo;
-    std::unique_ptr<JokerChange> jokerChange;
-    bool resultOfMoving, resultOfJokerChange;
-    char jokerPrevChar;
-
-    std::unique_ptr<Move> currMove = rpCurrPlayer->getMove();
-    if (currMove == nullptr) {
-        // no more moves for player, skip turn
-        return;
-    }
-    // execute player move
-    resultOfMoving = myBoard.movePiece(currPlayerNumber, currMove, fightInfo);
-    if (!resultOfMoving) {
-        // announce loser
-        rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
-        return;
-    }
-    // notify the opponent on a move
-    rpOppPlayer->notifyOnOpponentMove(*(currMove));
-    if (fightInfo != nullptr) {
-        // there was a fight
-        rpCurrPlayer->notifyFightResult(*fightInfo);
-        rpOppPlayer->notifyFightResult(*fightInfo);
-        rScoreManager.notifyFight(*fightInfo);
-    }
-    // handle joker change
-    jokerChange = rpCurrPlayer->getJokerChange();
-    if (jokerChange != nullptr) {
-        auto& jokerPiece = myBoard.getPieceAt(jokerChange->getJokerChangePosition());
-        if (jokerPiece == nullptr) {
-            rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
-            return;
-        }
-        jokerPrevChar = myBoard.getPieceAt(jokerChange->getJokerChangePosition())->getJokerRep();
-        resultOfJokerChange = myBoard.changeJoker(currPlayerNumber, jokerChange);
-        if (!resultOfJokerChange) {
-            rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
-            return;
-        }
-        rScoreManager.notifyJokerChange(*jokerChange, jokerPrevChar, currPlayerNumber);
-    }
+    // pre-parsed scripts are used instead of the text files when present and up to date (see rps_script)
+    return PlayRPS(vGameStyle, "./rps.output", "./player1.rps_board", "./player2.rps_board", "./player1.rps_moves", "./player2.rps_moves",
+        "./player1.rps_script", "./player2.rps_script");
 }
 
-/**
- * @brief - given a reference to a board and a vector of piece positions of one player, and a vector of FightInfo:
- * fills the board by positioning the pieces given at positioningVec. if any of the positions is bad, notifies ScoreManager about current player as loser and returns false
- * fills rpFightInfoVec with FightInfo instances for each fight that happened as a result of positioning the player's pieces on the board
- * 
- * @param rBoard - the board to be filled
- * @param vCurrPlayer - current player number
- * @param positioningVec - vector containing the current player's initial positionings
- * @param rpFightInfoVec - vector to be filled with all the fights that occured as a result of the above positioning on the board
- * @param rScoreManager - reference to the ScoreManager to be notified of a losing player as a result of bad positioning 
- * @return true - if all positionings are legal
- * @return false - if any of the positionings is "bad"
- */
-bool fillBoard(BoardRPS& rBoard, int vCurrPlayer, std::vector<std::unique_ptr<PiecePosition>>& positioningVec, std::vector<std::unique_ptr<FightInfo>>& rpFightInfoVec, ScoreManager& rScoreManager)
+int PlayRPS(int vGameStyle, const char* outfile_path, const char* p1_posfile_path, const char* p2_posfile_path, const char* p1_movfile_path, const char* p2_movfile_path,
+    const char* p1_scriptfile_path /*= nullptr*/, const char* p2_scriptfile_path /*= nullptr*/)
 {
-    bool resultOfPositioning;
-    char currPiece;
-    std::unique_ptr<FightInfo> thisFightInfo;
+    bool isAuto1, isAuto2;
 
-    for (int i = 0; i < positioningVec.size(); i++) {
-        currPiece = positioningVec[i]->getPiece() == JOKER_CHR ? positioningVec[i]->getJokerRep() : positioningVec[i]->getPiece();
-        resultOfPositioning = rBoard.placePiece(vCurrPlayer, positioningVec[i], thisFightInfo);
-        if (resultOfPositioning == false) {
-            // announce vCurrPlayer as losing
-            rScoreManager.dismissPlayer(vCurrPlayer, Reason::POSITION_FILE_ERROR);
-            return false;
-        }
-        rScoreManager.increaseNumOfPieces(vCurrPlayer, currPiece);
-        if (thisFightInfo != nullptr) {
-            rScoreManager.notifyFight(*thisFightInfo);
-            rpFightInfoVec.push_back(std::move(thisFightInfo));
-        }
+    if (!isAutoPlayer(vGameStyle, PLAYER_1, isAuto1) || !isAutoPlayer(vGameStyle, PLAYER_2, isAuto2)) {
+        return 1;
     }
-    return true;
+    GameSessionRPS session(isAuto1 ? GameSessionRPS::autoPlayer() : GameSessionRPS::filePlayer(p1_posfile_path, p1_movfile_path, p1_scriptfile_path ? p1_scriptfile_path : ""),
+        isAuto2 ? GameSessionRPS::autoPlayer() : GameSessionRPS::filePlayer(p2_posfile_path, p2_movfile_path, p2_scriptfile_path ? p2_scriptfile_path : ""),
+        GameSessionRPS::fileSink(outfile_path));
+    return session.play();
 }
 
-int PlayRPS(int vGameStyle)
+int PlaySweepRPS(int vGameStyle, int numOfGames, int numOfThreads, const char* outputDir /*= nullptr*/)
 {
-    const char* outfile_path = "./rps.output";
-    const char* p1_posfile_path = "./player1.rps_board";
-    const char* p2_posfile_path = "./player2.rps_board";
-    const char* p1_movfile_path = "./player1.rps_moves";
-    const char* p2_movfile_path = "./player2.rps_moves";
-
-    std::unique_ptr<PlayerAlgorithm> p1;
-    std::unique_ptr<PlayerAlgorithm> p2;
-    std::vector<std::unique_ptr<PiecePosition>> initPositionP1;
-    std::vector<std::unique_ptr<PiecePosition>> initPositionP2;
-    std::vector<std::unique_ptr<FightInfo>> fightsInfoVec;
-    bool fillRes1, fillRes2;
-    int currentPlayer, turn, winner;
-    const char* reason;
-
-    switch (vGameStyle) {
-    case 1:
-        p1 = std::make_unique<AutoPlayerAlgorithm>();
-        p2 = std::make_unique<AutoPlayerAlgorithm>();
-        break;
-    case 2:
-        p1 = std::make_unique<FilePlayerAlgorithm>(p1_posfile_path, p1_movfile_path);
-        p2 = std::make_unique<FilePlayerAlgorithm>(p2_posfile_path, p2_movfile_path);
-        break;
-    case 3:
-        p1 = std::make_unique<AutoPlayerAlgorithm>();
-        p2 = std::make_unique<FilePlayerAlgorithm>(p2_posfile_path, p2_movfile_path);
-        break;
-    case 4:
-        p1 = std::make_unique<FilePlayerAlgorithm>(p1_posfile_path, p1_movfile_path);
-        p2 = std::make_unique<AutoPlayerAlgorithm>();
-        break;
+    std::vector<std::thread> threads;
+    std::atomic<int> nextGame(0);
+    std::atomic<int> numOfFailures(0);
+    std::atomic<long> numOfTurns(0);
+    std::mutex resultLock;
+    std::map<std::string, int> reasons;
+    int wins[NUM_OF_PLAYERS + 1] = { 0 };
+    bool isAuto1, isAuto2;
+
+    if (!isAutoPlayer(vGameStyle, PLAYER_1, isAuto1) || !isAutoPlayer(vGameStyle, PLAYER_2, isAuto2) || numOfGames <= 0) {
+        return 1;
     }
-
-    // positioning
-    p1->getInitialPositions(PLAYER_1, initPositionP1);
-    p2->getInitialPositions(PLAYER_2, initPositionP2);
-
-    // since will be used only as long as this function in operating, chose to implement using an Lvalue
-    ScoreManager scoreManager;
-    BoardRPS myBoard(DIM_X, DIM_Y);
-
-    fillRes1 = fillBoard(myBoard, PLAYER_1, initPositionP1, fightsInfoVec, scoreManager);
-    fillRes2 = fillBoard(myBoard, PLAYER_2, initPositionP2, fightsInfoVec, scoreManager);
-    // if any of the players had bad positioning
-    if (!fillRes1 || !fillRes2) {
-        myBoard.clearBoard();
-        winner = scoreManager.getWinner();
-        reason = scoreManager.getReasonOfFinalResult();
-        return outputGameResult(outfile_path, myBoard, winner, reason);
+    numOfThreads = std::max(1, std::min(numOfThreads, numOfGames));
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            while ((i = nextGame++) < numOfGames) {
+                // the automatic players of game i are seeded by i, so a sweep can be replayed
+                GameSessionRPS session(isAuto1 ? GameSessionRPS::autoPlayer(i) : GameSessionRPS::filePlayer("./player1.rps_board", "./player1.rps_moves", "./player1.rps_script"),
+                    isAuto2 ? GameSessionRPS::autoPlayer(i) : GameSessionRPS::filePlayer("./player2.rps_board", "./player2.rps_moves", "./player2.rps_script"),
+                    outputDir ? GameSessionRPS::fileSink(std::string(outputDir) + "/rps.output." + std::to_string(i)) : GameSessionRPS::noSink());
+                if (session.play() != 0) {
+                    ++numOfFailures;
+                }
+                numOfTurns += session.getNumOfTurns();
+                std::lock_guard<std::mutex> lock(resultLock);
+                ++wins[session.getWinner() == GAME_IS_STILL_ON ? NO_PLAYER : session.getWinner()];
+                ++reasons[session.getReason()];
+            }
+        });
     }
-
-    // notify when game board was fully created
-    p1->notifyOnInitialBoard(myBoard, fightsInfoVec);
-    p2->notifyOnInitialBoard(myBoard, fightsInfoVec);
-
-    currentPlayer = PLAYER_1;
-    turn = 0;
-
-    while (turn < MAX_NUM_OF_MOVES && !scoreManager.isGameOver()) {
-        switch (currentPlayer) {
-        case PLAYER_1:
-            playCurrTurn(PLAYER_1, p1, p2, myBoard, scoreManager);
-            break;
-        case PLAYER_2:
-            playCurrTurn(PLAYER_2, p2, p1, myBoard, scoreManager);
-            break;
-        default:
-            break;
-        }
-        currentPlayer = (currentPlayer % NUM_OF_PLAYERS) + 1;
-        ++turn;
+    for (auto& thread : threads) {
+        thread.join();
     }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
 
-    if (scoreManager.isGameOver()) {
-        // game is over with a result
-        winner = scoreManager.getWinner();
-        reason = scoreManager.getReasonOfFinalResult();
-    } else if (turn >= MAX_NUM_OF_MOVES) {
-        // reached max number of turns without a result
-        winner = NO_PLAYER;
-        reason = RSN_MOVE_FILES_NO_WINNER;
+    std::cout << INFO << " Played " << numOfGames << " games (" << numOfTurns << " turns) in " << elapsed.count() << "ms, using " << numOfThreads << " threads." << std::endl;
+    std::cout << INFO << " Player 1 won " << wins[PLAYER_1] << ", player 2 won " << wins[PLAYER_2] << ", " << wins[NO_PLAYER] << " ties." << std::endl;
+    for (auto& reason : reasons) {
+        std::cout << "\t" << reason.second << "\t" << reason.first << std::endl;
     }
-
-    return outputGameResult(outfile_path, myBoard, winner, reason);
-}
\ No newline at end of file
+    return numOfFailures == 0 ? 0 : 1;
+}
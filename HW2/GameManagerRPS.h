@@ -16,4 +16,29 @@
  */
 int PlayRPS(int vGameStyle);
 
+/**
+ * @brief The full play of the RPS game, using the given input and output files (file players only use them).
+ * 
+ * @param vGameStyle An integer {1: auto-vs-auto, 2: file-vs-file, 3: auto-vs-file, 4: file-vs-auto}
+ * @param outfilePath The path of the output file
+ * @param p1PosfilePath, p2PosfilePath The paths of the positions files
+ * @param p1MovfilePath, p2MovfilePath The paths of the moves files
+ * @param p1ScriptfilePath, p2ScriptfilePath The paths of pre-parsed scripts, used instead of the text files if valid (nullptr for none)
+ * @return int - in case of success - 0, otherwise - 1
+ */
+int PlayRPS(int vGameStyle, const char* outfilePath, const char* p1PosfilePath, const char* p2PosfilePath, const char* p1MovfilePath, const char* p2MovfilePath,
+    const char* p1ScriptfilePath = nullptr, const char* p2ScriptfilePath = nullptr);
+
+/**
+ * @brief Plays many games of a game style in parallel, each in its own GameSessionRPS, and prints a summary of the results.
+ * The file players read the files of the current directory, the automatic players of game i are seeded by i.
+ *
+ * @param vGameStyle An integer {1: auto-vs-auto, 2: file-vs-file, 3: auto-vs-file, 4: file-vs-auto}
+ * @param numOfGames The number of games to play
+ * @param numOfThreads The number of threads playing the games
+ * @param outputDir The directory of the output files (rps.output.<game>), nullptr to keep only the summary
+ * @return int - in case of success - 0, otherwise - 1
+ */
+int PlaySweepRPS(int vGameStyle, int numOfGames, int numOfThreads, const char* outputDir = nullptr);
+
 #endif // !__H_GAME_MANAGER_RPS
\ No newline at end of file
@@ -0,0 +1,258 @@
+/**
+ * @brief The implementation file of the GameSessionRPS class.
+ *
+ * @file GameSessionRPS.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-28
+ */
+#include "GameSessionRPS.h"
+#include "AutoPlayerAlgorithm.h"
+#include "BoardRPS.h"
+#include "FilePlayerAlgorithm.h"
+#include "MoveRPS.h"
+#include "PieceRPS.h"
+#include "PointRPS.h"
+#include "ResultWriter.h"
+#include "ScoreManager.h"
+
+#include <cstring>
+#include <utility>
+
+GameSessionRPS::GameSessionRPS(PlayerFactory p1Factory, PlayerFactory p2Factory, ResultSink resultSink)
+    : _playerFactories { std::move(p1Factory), std::move(p2Factory) }
+    , _resultSink(std::move(resultSink))
+    , _winner(GAME_IS_STILL_ON)
+    , _reason("")
+    , _numOfTurns(0)
+{
+}
+
+/*static*/ GameSessionRPS::PlayerFactory GameSessionRPS::autoPlayer()
+{
+    return [] { return std::unique_ptr<PlayerAlgorithm>(std::make_unique<AutoPlayerAlgorithm>()); };
+}
+
+/*static*/ GameSessionRPS::PlayerFactory GameSessionRPS::autoPlayer(unsigned seed)
+{
+    return [seed] { return std::unique_ptr<PlayerAlgorithm>(std::make_unique<AutoPlayerAlgorithm>(seed)); };
+}
+
+/*static*/ GameSessionRPS::PlayerFactory GameSessionRPS::filePlayer(std::string positionFilePath, std::string moveFilePath, std::string scriptFilePath /*= ""*/)
+{
+    return [positionFilePath, moveFilePath, scriptFilePath] {
+        return std::unique_ptr<PlayerAlgorithm>(std::make_unique<FilePlayerAlgorithm>(positionFilePath.c_str(), moveFilePath.c_str(),
+            scriptFilePath.empty() ? nullptr : scriptFilePath.c_str()));
+    };
+}
+
+/*static*/ GameSessionRPS::ResultSink GameSessionRPS::fileSink(std::string path)
+{
+    // write errors are reported by ResultWriter::flush
+    return [path](std::string&& content) {
+        ResultWriter::get().write(path, std::move(content));
+        return true;
+    };
+}
+
+/*static*/ GameSessionRPS::ResultSink GameSessionRPS::stringSink(std::string& rContent)
+{
+    return [&rContent](std::string&& content) {
+        rContent = std::move(content);
+        return true;
+    };
+}
+
+/*static*/ GameSessionRPS::ResultSink GameSessionRPS::noSink()
+{
+    return [](std::string&&) { return true; };
+}
+
+/**
+ * @brief Formats the output of a game, describing:
+ * 1.winner 2.reason of winning 3.state of the board after the game is over
+ * The content is formatted into a single buffer.
+ *
+ * @param b - the board at the final state
+ * @param winner - winner of the game
+ * @param msg_reason - reason of winning as specified in the homework guidelines
+ * @return std::string - the content of the output file
+ */
+/*static*/ std::string GameSessionRPS::formatResult(const BoardRPS& b, int winner, const char* msg_reason)
+{
+    const char* winner_str = "Winner: ";
+    const char* reason_str = "\nReason: ";
+    std::string content;
+    std::size_t board_start;
+
+    // the header lines are short, reserve them along with the board
+    board_start = std::strlen(winner_str) + 1 + std::strlen(reason_str) + std::strlen(msg_reason) + 2;
+    content.reserve(board_start + b.getGridSize());
+    content.append(winner_str).append(std::to_string(winner)).append(reason_str).append(msg_reason).append("\n\n");
+    board_start = content.size();
+    content.resize(board_start + b.getGridSize());
+    b.fillGrid(&content[board_start]);
+    return content;
+}
+
+/**
+ * @brief - Asks for next move of current player and performs the move by calling BoardRPS member function
+ * if the move was not legal then it notifies the ScoreManager of current player as loser
+ * if the move was legal: 1. it notifies both player of the fight result, in case there was a fight
+ * 2. it notifies opponent player of the current move
+ * 3. in case there was a joker change, notifies the ScoreManager of it.
+ *
+ * @param currPlayerNumber - current player number which this is his turn
+ * @param rCurrPlayer - reference to current player which this is his turn
+ * @param rOppPlayer - reference to opponent player(which this is not his turn)
+ * @param rBoard - game board reference
+ * @param rScoreManager - ScoreManager reference
+ */
+void GameSessionRPS::playCurrTurn(int currPlayerNumber, PlayerAlgorithm& rCurrPlayer, PlayerAlgorithm& rOppPlayer, BoardRPS& rBoard, ScoreManager& rScoreManager)
+{
+    std::unique_ptr<FightInfo> fightInfo;
+    std::unique_ptr<JokerChange> jokerChange;
+    bool resultOfMoving, resultOfJokerChange;
+    char jokerPrevChar;
+
+    std::unique_ptr<Move> currMove = rCurrPlayer.getMove();
+    if (currMove == nullptr) {
+        // no more moves for player, skip turn
+        return;
+    }
+    // execute player move
+    resultOfMoving = rBoard.movePiece(currPlayerNumber, currMove, fightInfo);
+    if (!resultOfMoving) {
+        // announce loser
+        rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
+        return;
+    }
+    // notify the opponent on a move
+    rOppPlayer.notifyOnOpponentMove(*(currMove));
+    if (fightInfo != nullptr) {
+        // there was a fight
+        rCurrPlayer.notifyFightResult(*fightInfo);
+        rOppPlayer.notifyFightResult(*fightInfo);
+        rScoreManager.notifyFight(*fightInfo);
+    }
+    // handle joker change
+    jokerChange = rCurrPlayer.getJokerChange();
+    if (jokerChange != nullptr) {
+        auto& jokerPiece = rBoard.getPieceAt(jokerChange->getJokerChangePosition());
+        if (jokerPiece == nullptr) {
+            rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
+            return;
+        }
+        jokerPrevChar = rBoard.getPieceAt(jokerChange->getJokerChangePosition())->getJokerRep();
+        resultOfJokerChange = rBoard.changeJoker(currPlayerNumber, jokerChange);
+        if (!resultOfJokerChange) {
+            rScoreManager.dismissPlayer(currPlayerNumber, Reason::BAD_MOVE_ERROR);
+            return;
+        }
+        rScoreManager.notifyJokerChange(*jokerChange, jokerPrevChar, currPlayerNumber);
+    }
+}
+
+/**
+ * @brief - given a reference to a board and a vector of piece positions of one player, and a vector of FightInfo:
+ * fills the board by positioning the pieces given at positioningVec. if any of the positions is bad, notifies ScoreManager about current player as loser and returns false
+ * fills rpFightInfoVec with FightInfo instances for each fight that happened as a result of positioning the player's pieces on the board
+ *
+ * @param rBoard - the board to be filled
+ * @param vCurrPlayer - current player number
+ * @param positioningVec - vector containing the current player's initial positionings
+ * @param rpFightInfoVec - vector to be filled with all the fights that occured as a result of the above positioning on the board
+ * @param rScoreManager - reference to the ScoreManager to be notified of a losing player as a result of bad positioning
+ * @return true - if all positionings are legal
+ * @return false - if any of the positionings is "bad"
+ */
+bool GameSessionRPS::fillBoard(BoardRPS& rBoard, int vCurrPlayer, std::vector<std::unique_ptr<PiecePosition>>& positioningVec,
+    std::vector<std::unique_ptr<FightInfo>>& rpFightInfoVec, ScoreManager& rScoreManager)
+{
+    bool resultOfPositioning;
+    char currPiece;
+    std::unique_ptr<FightInfo> thisFightInfo;
+
+    for (int i = 0; i < (int)positioningVec.size(); i++) {
+        currPiece = positioningVec[i]->getPiece() == JOKER_CHR ? positioningVec[i]->getJokerRep() : positioningVec[i]->getPiece();
+        resultOfPositioning = rBoard.placePiece(vCurrPlayer, positioningVec[i], thisFightInfo);
+        if (resultOfPositioning == false) {
+            // announce vCurrPlayer as losing
+            rScoreManager.dismissPlayer(vCurrPlayer, Reason::POSITION_FILE_ERROR);
+            return false;
+        }
+        rScoreManager.increaseNumOfPieces(vCurrPlayer, currPiece);
+        if (thisFightInfo != nullptr) {
+            rScoreManager.notifyFight(*thisFightInfo);
+            rpFightInfoVec.push_back(std::move(thisFightInfo));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Plays a full game: creates the players, positions their pieces, plays the turns
+ * and hands the formatted result to the sink.
+ *
+ * @return int - 0 if the result was handed to the sink successfully, otherwise 1
+ */
+int GameSessionRPS::play()
+{
+    std::unique_ptr<PlayerAlgorithm> p1 = _playerFactories[PLAYER_1 - 1]();
+    std::unique_ptr<PlayerAlgorithm> p2 = _playerFactories[PLAYER_2 - 1]();
+    std::vector<std::unique_ptr<PiecePosition>> initPositionP1;
+    std::vector<std::unique_ptr<PiecePosition>> initPositionP2;
+    std::vector<std::unique_ptr<FightInfo>> fightsInfoVec;
+    ScoreManager scoreManager;
+    BoardRPS myBoard(DIM_X, DIM_Y);
+    bool fillRes1, fillRes2;
+    int currentPlayer;
+
+    _winner = GAME_IS_STILL_ON;
+    _reason = "";
+    _numOfTurns = 0;
+
+    // positioning
+    p1->getInitialPositions(PLAYER_1, initPositionP1);
+    p2->getInitialPositions(PLAYER_2, initPositionP2);
+
+    fillRes1 = fillBoard(myBoard, PLAYER_1, initPositionP1, fightsInfoVec, scoreManager);
+    fillRes2 = fillBoard(myBoard, PLAYER_2, initPositionP2, fightsInfoVec, scoreManager);
+    // if any of the players had bad positioning
+    if (!fillRes1 || !fillRes2) {
+        myBoard.clearBoard();
+        _winner = scoreManager.getWinner();
+        _reason = scoreManager.getReasonOfFinalResult();
+        return _resultSink(formatResult(myBoard, _winner, _reason)) ? 0 : 1;
+    }
+
+    // notify when game board was fully created
+    p1->notifyOnInitialBoard(myBoard, fightsInfoVec);
+    p2->notifyOnInitialBoard(myBoard, fightsInfoVec);
+
+    currentPlayer = PLAYER_1;
+    while (_numOfTurns < MAX_NUM_OF_MOVES && !scoreManager.isGameOver()) {
+        switch (currentPlayer) {
+        case PLAYER_1:
+            playCurrTurn(PLAYER_1, *p1, *p2, myBoard, scoreManager);
+            break;
+        case PLAYER_2:
+            playCurrTurn(PLAYER_2, *p2, *p1, myBoard, scoreManager);
+            break;
+        default:
+            break;
+        }
+        currentPlayer = (currentPlayer % NUM_OF_PLAYERS) + 1;
+        ++_numOfTurns;
+    }
+
+    if (scoreManager.isGameOver()) {
+        // game is over with a result
+        _winner = scoreManager.getWinner();
+        _reason = scoreManager.getReasonOfFinalResult();
+    } else {
+        // reached max number of turns without a result
+        _winner = NO_PLAYER;
+        _reason = RSN_MOVE_FILES_NO_WINNER;
+    }
+    return _resultSink(formatResult(myBoard, _winner, _reason)) ? 0 : 1;
+}
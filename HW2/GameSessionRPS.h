@@ -0,0 +1,78 @@
+/**
+ * @brief The header file of the GameSessionRPS class.
+ *
+ * @file GameSessionRPS.h
+ * @author Yotam Sechayk
+ * @date 2018-05-28
+ */
+#ifndef __H_GAME_SESSION_RPS
+#define __H_GAME_SESSION_RPS
+
+#include "GameUtilitiesRPS.h"
+#include "PlayerAlgorithm.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+class BoardRPS;
+class ScoreManager;
+
+/**
+ * @brief A single RPS game: the players are created by factories and the formatted result is handed to a sink.
+ * The session keeps no global state (the board, the score and the players live only while play() runs),
+ * so any number of sessions may be played in parallel threads.
+ *
+ */
+class GameSessionRPS {
+public:
+    // creates a player for a game
+    using PlayerFactory = std::function<std::unique_ptr<PlayerAlgorithm>()>;
+    // receives the output of a game (the same content as the output file), returns false if it failed
+    using ResultSink = std::function<bool(std::string&& content)>;
+
+private:
+    PlayerFactory _playerFactories[NUM_OF_PLAYERS]; // the factory of each player
+    ResultSink _resultSink; // where the result of the game goes
+    int _winner; // the winner of the last game (GAME_IS_STILL_ON before playing)
+    const char* _reason; // the reason of the result of the last game
+    int _numOfTurns; // the number of turns played in the last game
+
+public:
+    // c'tor, the factories are called for every game played
+    GameSessionRPS(PlayerFactory p1Factory, PlayerFactory p2Factory, ResultSink resultSink);
+
+    // plays a game, returns 0 if the result was handed to the sink successfully, otherwise 1
+    int play();
+
+    // gets the winner of the last game
+    int getWinner() const { return _winner; }
+    // gets the reason of the result of the last game
+    const char* getReason() const { return _reason; }
+    // gets the number of turns played in the last game
+    int getNumOfTurns() const { return _numOfTurns; }
+
+    // a factory of automatic players, seeded by the time
+    static PlayerFactory autoPlayer();
+    // a factory of automatic players with a given seed
+    static PlayerFactory autoPlayer(unsigned seed);
+    // a factory of file players (the script is used instead of the text files when valid, empty for none)
+    static PlayerFactory filePlayer(std::string positionFilePath, std::string moveFilePath, std::string scriptFilePath = "");
+    // a sink writing the output file through the ResultWriter (in the background)
+    static ResultSink fileSink(std::string path);
+    // a sink keeping the output in a string
+    static ResultSink stringSink(std::string& rContent);
+    // a sink dropping the output
+    static ResultSink noSink();
+
+private:
+    // plays the turn of a player
+    void playCurrTurn(int currPlayerNumber, PlayerAlgorithm& rCurrPlayer, PlayerAlgorithm& rOppPlayer, BoardRPS& rBoard, ScoreManager& rScoreManager);
+    // places the initial positions of a player on the board
+    bool fillBoard(BoardRPS& rBoard, int vCurrPlayer, std::vector<std::unique_ptr<PiecePosition>>& positioningVec,
+        std::vector<std::unique_ptr<FightInfo>>& rpFightInfoVec, ScoreManager& rScoreManager);
+    // formats the output of a game
+    static std::string formatResult(const BoardRPS& b, int winner, const char* msg_reason);
+};
+
+#endif // !__H_GAME_SESSION_RPS
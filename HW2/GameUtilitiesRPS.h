@@ -44,7 +44,7 @@
 #define FLAG_LIMIT 1
 
 // possible output messages
-#define BAD_ARGS_MESSAGE "Please enter (as the first argument): auto-vs-auto, file-vs-file, auto-vs-file or file-vs-auto and try again."
+#define BAD_ARGS_MESSAGE "Please enter (as the first argument): auto-vs-auto, file-vs-file, auto-vs-file, file-vs-auto, batch <manifest> [threads] or sweep <play type> <games> [threads] [output dir] and try again."
 #define RSN_ALL_FLAGS_CAPTURED "All flags of the opponent are captured"
 #define RSN_ALL_PIECES_EATEN "All moving PIECEs of the opponent are eaten"
 #define RSN_MOVE_FILES_NO_WINNER "A tie - both Moves input files done without a winner"
@@ -0,0 +1,330 @@
+/**
+ * @brief The implementation file of the MoveScript class.
+ *
+ * @file MoveScript.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-22
+ */
+#include "MoveScript.h"
+#include "GameUtilitiesRPS.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sys/stat.h>
+
+// the maximal number of words in a valid line (a move with a joker change)
+#define MAX_LINE_TOKENS 8
+// FNV-1a 32 bit parameters
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+// the records are written as is, make sure there is no padding in them
+static_assert(sizeof(MoveScript::position_record) == 6, "position_record must be packed");
+static_assert(sizeof(MoveScript::move_record) == 14, "move_record must be packed");
+
+MoveScript::MoveScript()
+    : _badPositioning(false)
+    , _positionFile()
+    , _moveFile()
+{
+}
+
+/**
+ * @brief Gets the size and modification time of a file, telling if it changed since the script was parsed.
+ *
+ * @param filePath - the path of the file
+ * @return source_stamp - the stamp of the file, all zero if it doesn't exist
+ */
+/*static*/ MoveScript::source_stamp MoveScript::stamp(const char* filePath)
+{
+    struct stat info;
+    source_stamp result = {};
+
+    if (stat(filePath, &info) == 0) {
+        result._M_size = (std::uint64_t)info.st_size;
+        result._M_mtime = (std::int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+    }
+    return result;
+}
+
+/**
+ * @brief Clamps a parsed coordinate into the record width. Coordinates this far out of the board are illegal either way.
+ *
+ * @param value - the parsed (0-based) coordinate
+ * @return std::int16_t - the coordinate to keep in the record
+ */
+/*static*/ std::int16_t MoveScript::toCoordinate(int value)
+{
+    return (std::int16_t)(value < INT16_MIN ? INT16_MIN : (value > INT16_MAX ? INT16_MAX : value));
+}
+
+/**
+ * @brief Parses the positions file and keeps the positioned pieces, stopping on the first bad line.
+ *
+ * @param file - the tokenizer of the positions file
+ * @return true - if parsing was done successfully
+ * @return false - if: 1.There is a bad formatted line 2.There are not enough flags 3.There are extra pieces than should be 4.There was any other problem in reading a line
+ */
+bool MoveScript::parsePositions(FileTokenizer& file)
+{
+    const char delim = ' ';
+    char piece_type;
+    bool is_joker;
+    int x, y;
+    FileTokenizer::token line;
+    FileTokenizer::token s_line[MAX_LINE_TOKENS];
+    int num_tokens;
+
+    // map which holds { key : piece-char, value = amount }
+    // where amount is a reverse counter (limit -> 0)
+    std::map<char, int> piece_count = { { ROCK_CHR, ROCK_LIMIT }, { PAPER_CHR, PAPER_LIMIT }, { SCISSORS_CHR, SCISSORS_LIMIT }, { FLAG_CHR, FLAG_LIMIT }, { BOMB_CHR, BOMB_LIMIT }, { JOKER_CHR, JOKER_LIMIT } };
+
+    // while file is open and not in the end of the file
+    while (file.isOpen() && !file.eof()) {
+        is_joker = false;
+        if (!file.readLine(line)) {
+            return false;
+        }
+        num_tokens = FileTokenizer::splitLine(line, delim, s_line, MAX_LINE_TOKENS);
+        if (num_tokens == 0) {
+            // no more positions to fetch, empty line
+            continue;
+        }
+        if (num_tokens < 3 || s_line[0].size() != 1 || piece_count.find(s_line[0].first()) == piece_count.end()) {
+            return false;
+        }
+        piece_type = s_line[0].first();
+        if (!FileTokenizer::parseInt(s_line[1], x) || !FileTokenizer::parseInt(s_line[2], y)) {
+            // number conversion error
+            return false;
+        }
+        --piece_count[piece_type];
+        // make sure the user doesn't add too many pieces
+        if (piece_count[piece_type] < 0) {
+            return false;
+        }
+        if (piece_type == JOKER_CHR) {
+            // joker piece
+            is_joker = true;
+            if (num_tokens != 4 || s_line[3].size() != 1) {
+                return false;
+            }
+            // since we don't need to mess with the piece_counter for joker-rep
+            // no need to check if it's a valid rep
+            // (will be checked in the piece placement)
+            piece_type = s_line[3].first();
+        }
+        this->_positions.push_back({ toCoordinate(x - 1), toCoordinate(y - 1), piece_type, (std::uint8_t)is_joker });
+    }
+    // check if not enough flags entered
+    if (piece_count[FLAG_CHR] > 0) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the next move from the moves file. A bad formatted line is kept as a bad move.
+ *
+ * @param file - the tokenizer of the moves file
+ * @param rMove - filled with the parsed move
+ * @return true - if a move (possibly bad) was parsed
+ * @return false - if the end of the file was reached
+ */
+bool MoveScript::parseMove(FileTokenizer& file, move_record& rMove)
+{
+    const char delim = ' ';
+    const char* joker_str = "J:";
+    FileTokenizer::token line;
+    FileTokenizer::token s_line[MAX_LINE_TOKENS];
+    int num_tokens;
+    int from_x, from_y, to_x, to_y;
+    int joker_x = 0, joker_y = 0;
+
+    // initialization (as a bad move)
+    rMove = { -1, -1, -1, -1, -1, -1, '\0', MOVE_FLAG_BAD };
+
+    if (!file.readLine(line)) {
+        // can't read the file, a bad move
+        return true;
+    }
+    num_tokens = FileTokenizer::splitLine(line, delim, s_line, MAX_LINE_TOKENS);
+    if (num_tokens == 0) {
+        // reached end of move file (or file is empty)
+        return false;
+    }
+    if (num_tokens < 4) {
+        return true;
+    }
+    if (num_tokens >= 8) {
+        if (!s_line[4].equals(joker_str)) {
+            return true;
+        }
+        rMove._M_flags |= MOVE_FLAG_JOKER_CHANGE;
+    }
+    if (!FileTokenizer::parseInt(s_line[0], from_x) || !FileTokenizer::parseInt(s_line[1], from_y)
+        || !FileTokenizer::parseInt(s_line[2], to_x) || !FileTokenizer::parseInt(s_line[3], to_y)) {
+        // number conversion error
+        return true;
+    }
+    if (rMove._M_flags & MOVE_FLAG_JOKER_CHANGE) {
+        if (num_tokens != 8 || s_line[7].size() != 1) {
+            return true;
+        }
+        if (!FileTokenizer::parseInt(s_line[5], joker_x) || !FileTokenizer::parseInt(s_line[6], joker_y)) {
+            // number conversion error
+            return true;
+        }
+        rMove._M_new_rep = s_line[7].first();
+        if (rMove._M_new_rep != ROCK_CHR && rMove._M_new_rep != PAPER_CHR && rMove._M_new_rep != SCISSORS_CHR && rMove._M_new_rep != BOMB_CHR) {
+            return true;
+        }
+    }
+    // all went well, keep the entered move
+    rMove._M_from_x = toCoordinate(from_x - 1);
+    rMove._M_from_y = toCoordinate(from_y - 1);
+    rMove._M_to_x = toCoordinate(to_x - 1);
+    rMove._M_to_y = toCoordinate(to_y - 1);
+    rMove._M_joker_x = toCoordinate(joker_x - 1);
+    rMove._M_joker_y = toCoordinate(joker_y - 1);
+    rMove._M_flags &= ~MOVE_FLAG_BAD;
+    return true;
+}
+
+/**
+ * @brief Parses the text input files of a player. The moves are parsed up to the end of the file, the first bad line
+ * or the maximal number of moves in a game (the rest of the file can't be played either way).
+ *
+ * @param positionFilePath - path to the positions file
+ * @param moveFilePath - path to the moves file
+ */
+void MoveScript::parse(const char* positionFilePath, const char* moveFilePath)
+{
+    FileTokenizer file;
+    move_record currMove;
+
+    this->_positions.clear();
+    this->_moves.clear();
+    // stamped before reading, a change while parsing makes the script stale
+    this->_positionFile = stamp(positionFilePath);
+    this->_moveFile = stamp(moveFilePath);
+
+    file.open(positionFilePath);
+    this->_badPositioning = !parsePositions(file);
+
+    file.open(moveFilePath);
+    while ((int)this->_moves.size() < MAX_NUM_OF_MOVES && parseMove(file, currMove)) {
+        this->_moves.push_back(currMove);
+        if (currMove._M_flags & MOVE_FLAG_BAD) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Calculates the FNV-1a checksum of all the records.
+ *
+ * @return std::uint32_t - the checksum
+ */
+std::uint32_t MoveScript::checksum() const
+{
+    std::uint32_t hash = FNV_OFFSET_BASIS;
+    const unsigned char* data;
+    std::size_t size;
+
+    data = reinterpret_cast<const unsigned char*>(this->_positions.data());
+    size = this->_positions.size() * sizeof(position_record);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    data = reinterpret_cast<const unsigned char*>(this->_moves.data());
+    size = this->_moves.size() * sizeof(move_record);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes the script into a binary file.
+ *
+ * @param scriptFilePath - the path of the script file to (over)write
+ * @return true - iff the file was written successfully
+ * @return false - otherwise
+ */
+bool MoveScript::save(const char* scriptFilePath) const
+{
+    header head;
+    std::ofstream out;
+
+    std::memcpy(head._M_magic, SCRIPT_MAGIC, sizeof(head._M_magic));
+    head._M_version = SCRIPT_VERSION;
+    head._M_flags = this->_badPositioning ? SCRIPT_FLAG_BAD_POSITIONING : 0;
+    head._M_reserved = 0;
+    head._M_num_of_positions = (std::uint32_t)this->_positions.size();
+    head._M_num_of_moves = (std::uint32_t)this->_moves.size();
+    head._M_checksum = checksum();
+    head._M_reserved2 = 0;
+    head._M_position_file = this->_positionFile;
+    head._M_move_file = this->_moveFile;
+
+    out.open(scriptFilePath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(this->_positions.data()), this->_positions.size() * sizeof(position_record));
+    out.write(reinterpret_cast<const char*>(this->_moves.data()), this->_moves.size() * sizeof(move_record));
+    out.close();
+    return !out.fail();
+}
+
+/**
+ * @brief Loads a binary script, reading all the records up front. The script is only loaded if the text files
+ * have the same size and modification time as when it was written, so it never replaces newer text files.
+ * On failure the script is left empty.
+ *
+ * @param scriptFilePath - the path of the script file
+ * @param positionFilePath - the path of the positions file the script replaces
+ * @param moveFilePath - the path of the moves file the script replaces
+ * @return true - if the script was loaded, its checksum matches and its text files didn't change
+ * @return false - otherwise
+ */
+bool MoveScript::load(const char* scriptFilePath, const char* positionFilePath, const char* moveFilePath)
+{
+    header head;
+    std::ifstream in(scriptFilePath, std::ios::binary);
+
+    this->_positions.clear();
+    this->_moves.clear();
+    this->_badPositioning = false;
+
+    if (!in.is_open() || !in.read(reinterpret_cast<char*>(&head), sizeof(head))) {
+        return false;
+    }
+    if (std::memcmp(head._M_magic, SCRIPT_MAGIC, sizeof(head._M_magic)) != 0 || head._M_version != SCRIPT_VERSION) {
+        return false;
+    }
+    // a stale script, the text files were changed after it was written
+    if (!(head._M_position_file == stamp(positionFilePath)) || !(head._M_move_file == stamp(moveFilePath))) {
+        return false;
+    }
+    // a game can't have more positions or moves than it has squares or turns, don't trust larger counts
+    if (head._M_num_of_positions > DIM_X * DIM_Y || head._M_num_of_moves > MAX_NUM_OF_MOVES) {
+        return false;
+    }
+    this->_positions.resize(head._M_num_of_positions);
+    this->_moves.resize(head._M_num_of_moves);
+    in.read(reinterpret_cast<char*>(this->_positions.data()), this->_positions.size() * sizeof(position_record));
+    in.read(reinterpret_cast<char*>(this->_moves.data()), this->_moves.size() * sizeof(move_record));
+    if (!in || checksum() != head._M_checksum) {
+        this->_positions.clear();
+        this->_moves.clear();
+        return false;
+    }
+    this->_badPositioning = (head._M_flags & SCRIPT_FLAG_BAD_POSITIONING) != 0;
+    this->_positionFile = head._M_position_file;
+    this->_moveFile = head._M_move_file;
+    return true;
+}
@@ -0,0 +1,117 @@
+/**
+ * @brief The header file of the MoveScript class.
+ *
+ * @file MoveScript.h
+ * @author Yotam Sechayk
+ * @date 2018-05-22
+ */
+#ifndef __H_MOVE_SCRIPT
+#define __H_MOVE_SCRIPT
+
+#include "FileTokenizer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// script file related
+#define SCRIPT_MAGIC "RPSS"
+#define SCRIPT_VERSION 2
+// header flags
+#define SCRIPT_FLAG_BAD_POSITIONING 1
+// move record flags
+#define MOVE_FLAG_JOKER_CHANGE 1
+#define MOVE_FLAG_BAD 2
+
+/**
+ * @brief The pre-parsed input of a file player: the initial positioning and all of the moves.
+ * Can be parsed from the text files (.rps_board, .rps_moves) or loaded from a compact binary script,
+ * either way the whole input is held in contiguous arrays so getting the next move costs no I/O.
+ *
+ * Script layout: a fixed header (magic, version, flags, records count, checksum of the records, and the size and
+ * modification time of the text files it was parsed from) followed by the position records and then the move records,
+ * all fixed width. A script whose text files changed since it was written isn't loaded.
+ * Coordinates are kept 0-based exactly as parsed (out of board values are kept out of board).
+ */
+class MoveScript {
+public:
+    // a single positioned piece (the player is given when the positions are retrieved)
+    struct position_record {
+        std::int16_t _M_x;
+        std::int16_t _M_y;
+        char _M_piece; // the piece type (the representation for jokers)
+        std::uint8_t _M_isJoker;
+    };
+    // a single move, optionally with a joker change
+    struct move_record {
+        std::int16_t _M_from_x;
+        std::int16_t _M_from_y;
+        std::int16_t _M_to_x;
+        std::int16_t _M_to_y;
+        std::int16_t _M_joker_x;
+        std::int16_t _M_joker_y;
+        char _M_new_rep;
+        std::uint8_t _M_flags; // MOVE_FLAG_*
+    };
+
+private:
+    // the size and modification time of a text file (all zero if it doesn't exist)
+    struct source_stamp {
+        std::uint64_t _M_size;
+        std::int64_t _M_mtime; // nanoseconds since the epoch
+        bool operator==(const source_stamp& other) const { return _M_size == other._M_size && _M_mtime == other._M_mtime; }
+    };
+    // the on-disk header of the script
+    struct header {
+        char _M_magic[4];
+        std::uint8_t _M_version;
+        std::uint8_t _M_flags; // SCRIPT_FLAG_*
+        std::uint16_t _M_reserved;
+        std::uint32_t _M_num_of_positions;
+        std::uint32_t _M_num_of_moves;
+        std::uint32_t _M_checksum; // of the position records followed by the move records
+        std::uint32_t _M_reserved2;
+        source_stamp _M_position_file; // the positions file the script was parsed from
+        source_stamp _M_move_file; // the moves file the script was parsed from
+    };
+
+    std::vector<position_record> _positions; // the positioning, in file order
+    std::vector<move_record> _moves; // the moves, in file order (a bad move is always the last)
+    bool _badPositioning; // true iff the positioning had a bad line (or not enough flags)
+    source_stamp _positionFile; // the positions file as it was parsed
+    source_stamp _moveFile; // the moves file as it was parsed
+
+public:
+    // basic c'tor (an empty script)
+    MoveScript();
+
+    // parses the text input files, any error is kept in the script as in the files
+    void parse(const char* positionFilePath, const char* moveFilePath);
+    // loads a binary script, false if it couldn't be read, is corrupted or its text files changed since
+    bool load(const char* scriptFilePath, const char* positionFilePath, const char* moveFilePath);
+    // writes the script as binary
+    bool save(const char* scriptFilePath) const;
+
+    // true iff the positioning should end with a bad position
+    bool isBadPositioning() const { return _badPositioning; }
+    // the positioning records
+    const std::vector<position_record>& getPositions() const { return _positions; }
+    // the number of moves in the script
+    int getNumOfMoves() const { return (int)_moves.size(); }
+    // get a move by index
+    const move_record& getMove(int index) const { return _moves[index]; }
+
+private:
+    // parses the positions file, false on a bad line or not enough flags
+    bool parsePositions(FileTokenizer& file);
+    // parses the next line of the moves file, false on end of file
+    bool parseMove(FileTokenizer& file, move_record& rMove);
+    // FNV-1a checksum of the records
+    std::uint32_t checksum() const;
+    // the size and modification time of a file
+    static source_stamp stamp(const char* filePath);
+    // clamps a parsed coordinate into the record width
+    static std::int16_t toCoordinate(int value);
+};
+
+#endif // !__H_MOVE_SCRIPT
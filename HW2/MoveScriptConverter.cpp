@@ -0,0 +1,37 @@
+/**
+ * @brief The offline tool converting the text input files of a file player into a pre-parsed binary script.
+ *
+ * @file MoveScriptConverter.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-22
+ */
+#include "GameUtilitiesRPS.h"
+#include "MoveScript.h"
+
+#include <iostream>
+
+#define MSG_INVALID_FORMAT "Please call using the following format: <exe> <positions file> <moves file> <script file>"
+
+int main(int argc, char** argv)
+{
+    MoveScript script;
+
+    if (argc != 4) {
+        std::cout << ERROR << " " << MSG_INVALID_FORMAT << std::endl;
+        return 1;
+    }
+
+    // parsing errors are kept in the script, the game treats them the same as in the text files
+    script.parse(argv[1], argv[2]);
+    if (!script.save(argv[3])) {
+        std::cout << ERROR << " Failed to write the script to '" << argv[3] << "'." << std::endl;
+        return 1;
+    }
+
+    std::cout << INFO << " Wrote " << script.getPositions().size() << " positions and " << script.getNumOfMoves() << " moves to '" << argv[3] << "'";
+    if (script.isBadPositioning()) {
+        std::cout << " (bad positioning)";
+    }
+    std::cout << "." << std::endl;
+    return 0;
+}
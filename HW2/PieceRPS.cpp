@@ -84,6 +84,20 @@ char PieceRPS::getJokerRep() const
     return _piece_type;
 }
 
+/**
+ * @brief Gets the printed char of the piece, upper case for player 1 and lower case otherwise.
+ * 
+ * @return char - the printed char
+ */
+char PieceRPS::toChar() const
+{
+    char type = getPiece();
+    if (getPlayer() == PLAYER_1) {
+        return (char)toupper(type);
+    }
+    return (char)tolower(type);
+}
+
 /**
  * @brief Overloading on the print to ostream (<<) operator.
  * 
@@ -93,11 +107,5 @@ char PieceRPS::getJokerRep() const
  */
 std::ostream& operator<<(std::ostream& output, const PieceRPS& piece)
 {
-    char type = piece.getPiece();
-    if (piece.getPlayer() == PLAYER_1) {
-        output << (char)toupper(type);
-    } else {
-        output << (char)tolower(type);
-    }
-    return output;
+    return output << piece.toChar();
 }
\ No newline at end of file
@@ -58,6 +58,8 @@ public:
     // utility
     // tells if current piece is a joker
     bool isJoker() { return _is_joker; }
+    // the char printed for the piece (upper case for player 1, lower case otherwise)
+    char toChar() const;
     // overloading the copy assignment operator '='
     PieceRPS& operator=(const PieceRPS& p);
     // no need for equivalance operator
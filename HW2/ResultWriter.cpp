@@ -0,0 +1,121 @@
+/**
+ * @brief The implementation file of the ResultWriter class.
+ *
+ * @file ResultWriter.cpp
+ * @author Yotam Sechayk
+ * @date 2018-05-26
+ */
+#include "ResultWriter.h"
+
+#include <cstdio>
+
+ResultWriter::ResultWriter()
+    : _inProgress(0)
+    , _failures(0)
+    , _stopping(false)
+{
+    this->_writer = std::thread(&ResultWriter::run, this);
+}
+
+ResultWriter::~ResultWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_stopping = true;
+    }
+    this->_queueEvent.notify_one();
+    if (this->_writer.joinable()) {
+        this->_writer.join();
+    }
+}
+
+/*static*/ ResultWriter& ResultWriter::get()
+{
+    static ResultWriter theResultWriter;
+    return theResultWriter;
+}
+
+/**
+ * @brief Queues a file to be written by the writer thread.
+ *
+ * @param path - the path of the file
+ * @param content - the full content of the file
+ */
+void ResultWriter::write(std::string path, std::string content)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_queue.push_back({ std::move(path), std::move(content) });
+    }
+    this->_queueEvent.notify_one();
+}
+
+/**
+ * @brief Waits until all the files queued so far are written.
+ *
+ * @return true - if all the writes since the last flush succeeded
+ * @return false - otherwise
+ */
+bool ResultWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    int failures;
+
+    this->_flushEvent.wait(lock, [this] { return this->_queue.empty() && this->_inProgress == 0; });
+    failures = this->_failures;
+    this->_failures = 0;
+    return failures == 0;
+}
+
+/**
+ * @brief The writer thread loop. Takes all the queued files at once and writes them outside of the lock.
+ *
+ */
+void ResultWriter::run()
+{
+    std::vector<pending_write> batch;
+    int failures;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->_mutex);
+            this->_queueEvent.wait(lock, [this] { return this->_stopping || !this->_queue.empty(); });
+            if (this->_queue.empty()) {
+                // stopping, and nothing left to write
+                break;
+            }
+            batch.swap(this->_queue);
+            this->_inProgress = (int)batch.size();
+        }
+        failures = 0;
+        for (auto& file : batch) {
+            failures += writeFile(file) ? 0 : 1;
+        }
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            this->_inProgress = 0;
+            this->_failures += failures;
+        }
+        this->_flushEvent.notify_all();
+    }
+}
+
+/**
+ * @brief Writes a single file (truncating it if exists).
+ *
+ * @param file - the file to write
+ * @return true - if the file was written successfully
+ * @return false - otherwise
+ */
+/*static*/ bool ResultWriter::writeFile(const pending_write& file)
+{
+    std::FILE* out = std::fopen(file._M_path.c_str(), "w");
+    bool success;
+
+    if (out == nullptr) {
+        return false;
+    }
+    success = std::fwrite(file._M_content.data(), 1, file._M_content.size(), out) == file._M_content.size();
+    return std::fclose(out) == 0 && success;
+}
@@ -0,0 +1,67 @@
+/**
+ * @brief The header file of the ResultWriter class.
+ *
+ * @file ResultWriter.h
+ * @author Yotam Sechayk
+ * @date 2018-05-26
+ */
+#ifndef __H_RESULT_WRITER
+#define __H_RESULT_WRITER
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A sink of output files, written by a single background thread.
+ * Game threads only queue the (already formatted) content, the writer thread takes all the
+ * pending files at once and writes them, so games never block on the file system.
+ *
+ */
+class ResultWriter {
+private:
+    // a file waiting to be written
+    struct pending_write {
+        std::string _M_path;
+        std::string _M_content;
+    };
+
+    std::vector<pending_write> _queue; // the files waiting to be written
+    int _inProgress; // the number of files taken by the writer and not yet written
+    int _failures; // the number of failed writes since the last flush
+    bool _stopping; // true when the writer should exit (after writing all the queue)
+    std::mutex _mutex; // guards all of the above
+    std::condition_variable _queueEvent; // signaled when files are queued (or when stopping)
+    std::condition_variable _flushEvent; // signaled when the writer is done with a batch
+    std::thread _writer; // the writer thread
+
+    // basic c'tor, starts the writer thread
+    ResultWriter();
+
+public:
+    // no need for copy c'tor
+    ResultWriter(const ResultWriter& other) = delete;
+    // d'tor, writes all the queued files and stops the writer thread
+    ~ResultWriter();
+
+    // no need for copy assignment
+    ResultWriter& operator=(const ResultWriter& other) = delete;
+
+    // gets the writer of the process (started on first use)
+    static ResultWriter& get();
+
+    // queues a file to be written (overwritten if exists)
+    void write(std::string path, std::string content);
+    // waits until all the queued files are written, false if any write failed since the last flush
+    bool flush();
+
+private:
+    // the writer thread loop
+    void run();
+    // writes a single file
+    static bool writeFile(const pending_write& file);
+};
+
+#endif // !__H_RESULT_WRITER
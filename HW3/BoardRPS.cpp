@@ -46,14 +46,89 @@ bool BoardRPS::isPositionValid(int x, int y, int new_x, int new_y)
 }
 
 /**
- * @brief Empties the board of pieces, clears it.
+ * @brief Empties the board of pieces, clears it. Only the occupied cells are visited.
  * 
  */
 void BoardRPS::clearBoard()
 {
-    for (int i = 0; i < (int)this->_board.size(); ++i) {
-        this->_board[i] = nullptr;
+    for (int pos : this->_occupied) {
+        this->_board[pos] = nullptr;
+        this->_occupiedIndex[pos] = -1;
     }
+    this->_occupied.clear();
+    this->_hash = 0;
+}
+
+/**
+ * @brief Hashes a piece in a cell (splitmix64 of the cell, the owner and the piece), the hash of a position
+ * is the xor of its cells so it can be updated a cell at a time.
+ * 
+ * @param pos - the vector position of the cell
+ * @param rPiece - the piece in the cell
+ * @return std::uint64_t - the hash
+ */
+/*static*/ std::uint64_t BoardRPS::cellHash(int pos, const PieceRPS& rPiece)
+{
+    std::uint64_t z = ((std::uint64_t)pos << 24) | ((std::uint64_t)rPiece.getPlayer() << 16)
+        | ((std::uint64_t)(unsigned char)rPiece.getPiece() << 8) | (std::uint64_t)(unsigned char)rPiece.getJokerRep();
+
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Puts a piece in an empty cell and marks the cell as occupied.
+ * 
+ * @param pos - the vector position of the cell
+ * @param rrpPiece - the piece
+ */
+void BoardRPS::setCell(int pos, std::unique_ptr<PieceRPS>&& rrpPiece)
+{
+    assert(this->_board[pos] == nullptr);
+    this->_board[pos] = std::move(rrpPiece);
+    this->_hash ^= cellHash(pos, *this->_board[pos]);
+    this->_occupiedIndex[pos] = (int)this->_occupied.size();
+    this->_occupied.push_back(pos);
+}
+
+/**
+ * @brief Removes the piece of an occupied cell and marks the cell as empty.
+ * The last occupied cell takes the place of the cell in the occupied cells.
+ * 
+ * @param pos - the vector position of the cell
+ */
+void BoardRPS::emptyCell(int pos)
+{
+    int index = this->_occupiedIndex[pos];
+    int last = this->_occupied.back();
+
+    assert(this->_board[pos] != nullptr);
+    this->_hash ^= cellHash(pos, *this->_board[pos]);
+    this->_board[pos] = nullptr;
+    this->_occupied[index] = last;
+    this->_occupiedIndex[last] = index;
+    this->_occupied.pop_back();
+    this->_occupiedIndex[pos] = -1;
+}
+
+/**
+ * @brief Moves the piece of an occupied cell to an empty cell, the destination takes its place in the occupied cells.
+ * 
+ * @param from - the vector position of the occupied cell
+ * @param to - the vector position of the empty cell
+ */
+void BoardRPS::moveCell(int from, int to)
+{
+    int index = this->_occupiedIndex[from];
+
+    assert(this->_board[from] != nullptr && this->_board[to] == nullptr);
+    this->_board[to] = std::move(this->_board[from]);
+    this->_hash ^= cellHash(from, *this->_board[to]) ^ cellHash(to, *this->_board[to]);
+    this->_occupied[index] = to;
+    this->_occupiedIndex[to] = index;
+    this->_occupiedIndex[from] = -1;
 }
 
 /**
@@ -78,6 +153,9 @@ BoardRPS& BoardRPS::operator=(BoardRPS&& rrOther)
     this->_n = rrOther._n;
     this->_m = rrOther._m;
     std::swap(this->_board, rrOther._board);
+    std::swap(this->_occupied, rrOther._occupied);
+    std::swap(this->_occupiedIndex, rrOther._occupiedIndex);
+    std::swap(this->_hash, rrOther._hash);
     return *this;
 }
 
@@ -128,13 +206,16 @@ bool BoardRPS::placePiece(int player, std::unique_ptr<PiecePosition>& rpPiece, s
         }
         if (rpFightInfo->getWinner() == 0) {
             // both lose : remove existing piece
-            this->_board[p(x, y)] = nullptr;
+            emptyCell(p(x, y));
             rpPiece = nullptr;
             return true;
         }
     }
     // no fight or 'this' player won
-    this->_board[p(x, y)] = std::move(rpCurrPiece);
+    if (this->_board[p(x, y)] != nullptr) {
+        emptyCell(p(x, y));
+    }
+    setCell(p(x, y), std::move(rpCurrPiece));
     return true;
 }
 
@@ -190,20 +271,21 @@ bool BoardRPS::movePiece(int player, const std::unique_ptr<Move>& rpMove, std::u
         rpFightInfo = std::make_unique<FightInfoRPS>(*(this->_board[p(new_x, new_y)]), *(this->_board[p(x, y)]), PointRPS(new_x, new_y));
         if (rpFightInfo->getWinner() == this->_board[p(new_x, new_y)]->getPlayer()) {
             // destination piece won : empty 'origin' piece
-            this->_board[p(x, y)] = nullptr;
+            emptyCell(p(x, y));
             return true;
         }
         if (rpFightInfo->getWinner() == 0) {
             // both lose : empty existing pieces
-            this->_board[p(x, y)] = nullptr;
-            this->_board[p(new_x, new_y)] = nullptr;
+            emptyCell(p(x, y));
+            emptyCell(p(new_x, new_y));
             return true;
         }
     }
     // 'origin' piece won
-    this->_board[p(new_x, new_y)] = std::move(this->_board[p(x, y)]);
-    // place nullptr in origin (just in case)
-    this->_board[p(x, y)] = nullptr;
+    if (this->_board[p(new_x, new_y)] != nullptr) {
+        emptyCell(p(new_x, new_y));
+    }
+    moveCell(p(x, y), p(new_x, new_y));
     return true;
 }
 
@@ -230,7 +312,9 @@ bool BoardRPS::changeJoker(int player, const std::unique_ptr<JokerChange>& rpJok
         return false;
     }
     // can change the piece type of the joker
+    this->_hash ^= cellHash(p(x, y), *this->_board[p(x, y)]);
     this->_board[p(x, y)]->setType(new_type);
+    this->_hash ^= cellHash(p(x, y), *this->_board[p(x, y)]);
     return true;
 }
 
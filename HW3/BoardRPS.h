@@ -14,6 +14,7 @@
 #include "JokerChangeRPS.h"
 #include "MoveRPS.h"
 #include "PieceRPS.h"
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -28,6 +29,12 @@ private:
     int _m; // columns
     // the board vector is of size : rows * columns
     std::vector<std::unique_ptr<PieceRPS>> _board;
+    // the occupied cells (by vector position, in no order), so clearing the board costs as the number of pieces
+    std::vector<int> _occupied;
+    // for every cell: its index in _occupied, or -1 if the cell is empty
+    std::vector<int> _occupiedIndex;
+    // the hash of the position: the xor of the hashes of the occupied cells, updated on every change
+    std::uint64_t _hash = 0;
 
 public:
     // basic c'tors
@@ -35,7 +42,9 @@ public:
         : _n(n) // the number of rows
         , _m(m) // the number of columns
         , _board(_n * _m) // initialize the board vector
+        , _occupiedIndex(_n * _m, -1) // all the cells are empty
     {
+        _occupied.reserve(_n * _m);
     }
     // no need for copy c'tor
     BoardRPS(const BoardRPS& other) = delete;
@@ -45,6 +54,9 @@ public:
         , _m(other._m) // the number of columns
     {
         std::swap(this->_board, other._board);
+        std::swap(this->_occupied, other._occupied);
+        std::swap(this->_occupiedIndex, other._occupiedIndex);
+        std::swap(this->_hash, other._hash);
     }
 
     // d'tor
@@ -53,11 +65,15 @@ public:
     // getters
     // gets a reference to the pointer of a piece in position
     const std::unique_ptr<PieceRPS>& getPieceAt(const Point& point) const;
+    // gets the number of pieces on the board
+    int getNumOfPieces() const { return (int)_occupied.size(); }
+    // gets the hash of the position (the pieces, their owners and the joker representations)
+    std::uint64_t getHash() const { return _hash; }
 
     // utility
     // move assignment
     BoardRPS& operator=(BoardRPS&& b);
-    // clears the board of pieces
+    // clears the board of pieces (the board may then be reused for another game)
     void clearBoard();
     // place a piece on the board, update fight info accordingly
     bool placePiece(int player, std::unique_ptr<PiecePosition>& rpPiece, std::unique_ptr<FightInfo>& rpFightInfo);
@@ -83,6 +99,14 @@ private:
     bool isMoveLegal(int player, int x, int y, int new_x, int new_y);
     // calculates the correct vector position
     int p(int x, int y) const { return (y - 1) * _m + (x - 1); }
+    // puts a piece in an empty cell
+    void setCell(int pos, std::unique_ptr<PieceRPS>&& rrpPiece);
+    // removes the piece of an occupied cell
+    void emptyCell(int pos);
+    // moves the piece of an occupied cell to an empty cell
+    void moveCell(int from, int to);
+    // the hash of a piece in a cell
+    static std::uint64_t cellHash(int pos, const PieceRPS& rPiece);
 
 public:
     // friend method, overloading '<<' for printing the board
@@ -0,0 +1,68 @@
+/**
+ * @brief The implementation file of the DrawDetector class.
+ *
+ * @file DrawDetector.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-12
+ */
+#include "DrawDetector.h"
+
+#include <algorithm>
+
+DrawDetector::DrawDetector()
+    : _numOfPieces(0)
+    , _turnsWithoutFight(0)
+{
+    // a game has at most MAX_NUM_OF_MOVES positions
+    _positions.reserve(MAX_NUM_OF_MOVES + 1);
+}
+
+/**
+ * @brief Starts following a game. The initial board is the first position, with the first player to move.
+ *
+ * @param rRules - the rules of the game
+ * @param rBoard - the board after the positioning
+ */
+void DrawDetector::reset(const draw_rules& rRules, const BoardRPS& rBoard)
+{
+    _rules = rRules;
+    _positions.clear();
+    _numOfPieces = rBoard.getNumOfPieces();
+    _turnsWithoutFight = 0;
+    if (_rules._M_maxRepetitions > 0) {
+        _positions.push_back(rBoard.getHash() ^ PLAYER_1);
+    }
+}
+
+/**
+ * @brief Follows a played turn. A turn fought if it removed pieces from the board.
+ *
+ * @param rBoard - the board after the turn
+ * @param nextPlayer - the player to move next
+ * @return true - if the position was reached _M_maxRepetitions times, or there was no fight for _M_maxTurnsWithoutFight turns
+ * @return false - otherwise
+ */
+bool DrawDetector::isDraw(const BoardRPS& rBoard, int nextPlayer)
+{
+    std::uint64_t position;
+
+    if (rBoard.getNumOfPieces() != _numOfPieces) {
+        // the positions before the fight can't be reached again
+        _numOfPieces = rBoard.getNumOfPieces();
+        _turnsWithoutFight = 0;
+        _positions.clear();
+    } else {
+        ++_turnsWithoutFight;
+    }
+    if (_rules._M_maxTurnsWithoutFight > 0 && _turnsWithoutFight >= _rules._M_maxTurnsWithoutFight) {
+        return true;
+    }
+    if (_rules._M_maxRepetitions > 0) {
+        position = rBoard.getHash() ^ nextPlayer;
+        _positions.push_back(position);
+        if (std::count(_positions.begin(), _positions.end(), position) >= _rules._M_maxRepetitions) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+/**
+ * @brief The header file of the DrawDetector class.
+ *
+ * @file DrawDetector.h
+ * @author Yotam Sechayk
+ * @date 2018-07-12
+ */
+#ifndef __H_DRAW_DETECTOR
+#define __H_DRAW_DETECTOR
+
+#include "BoardRPS.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The rules ending a game early as a draw, set per tournament. Both are disabled by default.
+ *
+ */
+struct draw_rules {
+    int _M_maxRepetitions = 0; // a position reached this many times ends the game (0 to disable, otherwise at least 2)
+    int _M_maxTurnsWithoutFight = 0; // this many turns in a row without a fight end the game (0 to disable)
+
+    // true iff any of the rules is enabled
+    bool isEnabled() const { return _M_maxRepetitions > 0 || _M_maxTurnsWithoutFight > 0; }
+};
+
+/**
+ * @brief Follows the positions of a game, turn by turn, and tells when it ended as a draw by the rules.
+ * A position is the board hash along with the player to move. Every fight removes pieces from the board,
+ * so only the positions since the last fight may repeat, and only those are kept.
+ * A detector isn't thread safe, use a detector per thread.
+ *
+ */
+class DrawDetector {
+private:
+    draw_rules _rules; // the rules of the current game
+    std::vector<std::uint64_t> _positions; // the positions since the last fight
+    int _numOfPieces; // the number of pieces on the board after the last turn
+    int _turnsWithoutFight; // the number of turns since the last fight
+
+public:
+    // basic c'tor
+    DrawDetector();
+
+    // starts following a game, from its initial board
+    void reset(const draw_rules& rRules, const BoardRPS& rBoard);
+    // follows a played turn, true iff the game ended as a draw
+    bool isDraw(const BoardRPS& rBoard, int nextPlayer);
+};
+
+#endif // !__H_DRAW_DETECTOR
@@ -14,8 +14,36 @@
 
 GameManager GameManager::instance;
 
+/**
+ * @brief Clears everything left from a game, keeping the allocated vectors.
+ * The objects the players created (their positions) are released here, while their plugin is still loaded.
+ * 
+ */
+void game_context::reset()
+{
+    _M_board.clearBoard();
+    _M_scoreManager.reset();
+    for (auto& rInitPositions : _M_initPositions) {
+        rInitPositions.clear();
+    }
+    _M_fightsInfo.clear();
+}
+
+/**
+ * @brief Gets the context of the calling thread, created on its first game and reused by the following ones.
+ * 
+ * @return game_context& - the context, empty (every game resets it when it ends)
+ */
+/*static*/ game_context& GameManager::localContext()
+{
+    static thread_local game_context context;
+    return context;
+}
+
 /**
  * @brief - Asks for next move of current player and performs the move by calling BoardRPS member function
+ * if the current player is over its time budget (before or by asking for the move), it loses on time: the turn is skipped and the
+ * ScoreManager is notified of the current player as loser
  * if the move was not legal then it notifies the ScoreManager of current player as loser
  * if the move was legal: 1. it notifies both player of the fight result, in case there was a fight
  * 2. it notifies opponent player of the current move
@@ -26,17 +54,47 @@ GameManager GameManager::instance;
  * @param rpOppPlayer - reference to opponent player(which this is not his turn)
  * @param myBoard - game board reference
  * @param rScoreManager - ScoreManager reference
+ * @param pRecord - the record of the game, the turn is appended to it (nullptr if not recording)
+ * @param rCurrClock - measures the calls to the current player
+ * @param rOppClock - measures the calls to the opponent player
  */
-void GameManager::playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgorithm>& rpCurrPlayer, std::unique_ptr<PlayerAlgorithm>& rpOppPlayer, BoardRPS& myBoard, ScoreManager& rScoreManager)
+void GameManager::playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgorithm>& rpCurrPlayer, std::unique_ptr<PlayerAlgorithm>& rpOppPlayer, BoardRPS& myBoard, ScoreManager& rScoreManager, GameRecord* pRecord,
+    PlayerClock& rCurrClock, PlayerClock& rOppClock)
 {
+    std::unique_ptr<Move> currMove;
     std::unique_ptr<FightInfo> fightInfo;
     std::unique_ptr<JokerChange> jokerChange;
     bool resultOfMoving, resultOfJokerChange;
     char jokerPrevChar;
 
-    std::unique_ptr<Move> currMove = rpCurrPlayer->getMove();
+    // records the turn as it ended, on every return
+    auto recordTurn = [&](bool dismissed) {
+        if (pRecord != nullptr) {
+            pRecord->addTurn(currMove.get(), fightInfo.get(), jokerChange.get(), dismissed);
+        }
+    };
+    // a loss on time is recorded as a skipped turn of a dismissed player
+    auto loseOnTime = [&]() {
+        currMove = nullptr;
+        rScoreManager.dismissPlayer(currPlayerNumber);
+        rCurrClock.addForfeit();
+        recordTurn(true);
+    };
+
+    if (rCurrClock.isOverBudget()) {
+        // went over the budget since its last turn
+        loseOnTime();
+        return;
+    }
+    currMove = rCurrClock.call("getMove", [&] { return rpCurrPlayer->getMove(); });
+    if (rCurrClock.isOverBudget()) {
+        // the move is dropped
+        loseOnTime();
+        return;
+    }
     if (currMove == nullptr) {
         // no more moves for player, skip turn
+        recordTurn(false);
         return;
     }
     // execute player move
@@ -44,32 +102,36 @@ void GameManager::playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgor
     if (!resultOfMoving) {
         // announce loser
         rScoreManager.dismissPlayer(currPlayerNumber);
+        recordTurn(true);
         return;
     }
     // notify the opponent on a move
-    rpOppPlayer->notifyOnOpponentMove(*(currMove));
+    rOppClock.call("notifyOnOpponentMove", [&] { rpOppPlayer->notifyOnOpponentMove(*(currMove)); });
     if (fightInfo != nullptr) {
         // there was a fight
-        rpCurrPlayer->notifyFightResult(*fightInfo);
-        rpOppPlayer->notifyFightResult(*fightInfo);
+        rCurrClock.call("notifyFightResult", [&] { rpCurrPlayer->notifyFightResult(*fightInfo); });
+        rOppClock.call("notifyFightResult", [&] { rpOppPlayer->notifyFightResult(*fightInfo); });
         rScoreManager.notifyFight(*fightInfo);
     }
     // handle joker change
-    jokerChange = rpCurrPlayer->getJokerChange();
+    jokerChange = rCurrClock.call("getJokerChange", [&] { return rpCurrPlayer->getJokerChange(); });
     if (jokerChange != nullptr) {
         auto& jokerPiece = myBoard.getPieceAt(jokerChange->getJokerChangePosition());
         if (jokerPiece == nullptr) {
             rScoreManager.dismissPlayer(currPlayerNumber);
+            recordTurn(true);
             return;
         }
         jokerPrevChar = myBoard.getPieceAt(jokerChange->getJokerChangePosition())->getJokerRep();
         resultOfJokerChange = myBoard.changeJoker(currPlayerNumber, jokerChange);
         if (!resultOfJokerChange) {
             rScoreManager.dismissPlayer(currPlayerNumber);
+            recordTurn(true);
             return;
         }
         rScoreManager.notifyJokerChange(*jokerChange, jokerPrevChar, currPlayerNumber);
     }
+    recordTurn(false);
 }
 
 /**
@@ -113,61 +175,94 @@ bool GameManager::fillBoard(BoardRPS& rBoard, int vCurrPlayer, std::vector<std::
  * 
  * @param p1 
  * @param p2 
+ * @param pRecord - if given, the placements, the turns and the winner are recorded into it (appended to what it holds)
+ * @param rRules - the rules ending the game early as a draw (disabled by default)
+ * @param pTiming - if given, every call to the players is measured into its latency histograms, and a player over
+ * its budgets loses at its next turn (the positioning is charged to the first turn)
  * @return int - winner: 0,1 or 2
  */
-int GameManager::PlayRPS(std::unique_ptr<PlayerAlgorithm> p1, std::unique_ptr<PlayerAlgorithm> p2)
+int GameManager::PlayRPS(std::unique_ptr<PlayerAlgorithm> p1, std::unique_ptr<PlayerAlgorithm> p2, GameRecord* pRecord, const draw_rules& rRules, game_timing* pTiming)
 {
-    std::vector<std::unique_ptr<PiecePosition>> initPositionP1;
-    std::vector<std::unique_ptr<PiecePosition>> initPositionP2;
-    std::vector<std::unique_ptr<FightInfo>> fightsInfoVec;
-    bool fillRes1, fillRes2;
+    game_context& rContext = localContext();
+    // resets the context on every return, nothing of the players is kept after the game
+    struct context_guard {
+        game_context& _M_context;
+        ~context_guard() { _M_context.reset(); }
+    } guard { rContext };
+    BoardRPS& myBoard = rContext._M_board;
+    ScoreManager& scoreManager = rContext._M_scoreManager;
+    std::vector<std::unique_ptr<PiecePosition>>& initPositionP1 = rContext._M_initPositions[PLAYER_1 - 1];
+    std::vector<std::unique_ptr<PiecePosition>>& initPositionP2 = rContext._M_initPositions[PLAYER_2 - 1];
+    std::vector<std::unique_ptr<FightInfo>>& fightsInfoVec = rContext._M_fightsInfo;
+    PlayerClock& clockP1 = rContext._M_clocks[PLAYER_1 - 1];
+    PlayerClock& clockP2 = rContext._M_clocks[PLAYER_2 - 1];
+    bool fillRes1, fillRes2, drawn;
     int currentPlayer, turn, winner;
 
-    // positioning
-    p1->getInitialPositions(PLAYER_1, initPositionP1);
-    p2->getInitialPositions(PLAYER_2, initPositionP2);
+    if (pTiming != nullptr) {
+        clockP1.reset(&pTiming->_M_control, &pTiming->_M_latency[PLAYER_1 - 1], pTiming->_M_ids[PLAYER_1 - 1]);
+        clockP2.reset(&pTiming->_M_control, &pTiming->_M_latency[PLAYER_2 - 1], pTiming->_M_ids[PLAYER_2 - 1]);
+    } else {
+        clockP1.reset(nullptr, nullptr);
+        clockP2.reset(nullptr, nullptr);
+    }
 
-    // since will be used only as long as this function in operating, chose to implement using an Lvalue
-    ScoreManager scoreManager;
-    BoardRPS myBoard(DIM_X, DIM_Y);
+    // positioning
+    clockP1.call("getInitialPositions", [&] { p1->getInitialPositions(PLAYER_1, initPositionP1); });
+    clockP2.call("getInitialPositions", [&] { p2->getInitialPositions(PLAYER_2, initPositionP2); });
+    if (pRecord != nullptr) {
+        // recorded before filling the board, which consumes the positions
+        pRecord->addPlacements(PLAYER_1, initPositionP1);
+        pRecord->addPlacements(PLAYER_2, initPositionP2);
+    }
 
     fillRes1 = fillBoard(myBoard, PLAYER_1, initPositionP1, fightsInfoVec, scoreManager);
     fillRes2 = fillBoard(myBoard, PLAYER_2, initPositionP2, fightsInfoVec, scoreManager);
     // if any of the players had bad positioning
     if (!fillRes1 || !fillRes2) {
-        myBoard.clearBoard();
         winner = scoreManager.getWinner();
+        if (pRecord != nullptr) {
+            pRecord->setWinner(winner);
+        }
         return winner;
     }
 
     // notify when game board was fully created
-    p1->notifyOnInitialBoard(myBoard, fightsInfoVec);
-    p2->notifyOnInitialBoard(myBoard, fightsInfoVec);
+    clockP1.call("notifyOnInitialBoard", [&] { p1->notifyOnInitialBoard(myBoard, fightsInfoVec); });
+    clockP2.call("notifyOnInitialBoard", [&] { p2->notifyOnInitialBoard(myBoard, fightsInfoVec); });
 
     currentPlayer = PLAYER_1;
     turn = 0;
+    drawn = false;
+    rContext._M_drawDetector.reset(rRules, myBoard);
 
-    while (turn < MAX_NUM_OF_MOVES && !scoreManager.isGameOver()) {
+    while (turn < MAX_NUM_OF_MOVES && !scoreManager.isGameOver() && !drawn) {
         switch (currentPlayer) {
         case PLAYER_1:
-            playCurrTurn(PLAYER_1, p1, p2, myBoard, scoreManager);
+            playCurrTurn(PLAYER_1, p1, p2, myBoard, scoreManager, pRecord, clockP1, clockP2);
             break;
         case PLAYER_2:
-            playCurrTurn(PLAYER_2, p2, p1, myBoard, scoreManager);
+            playCurrTurn(PLAYER_2, p2, p1, myBoard, scoreManager, pRecord, clockP2, clockP1);
             break;
         default:
             break;
         }
         currentPlayer = (currentPlayer % NUM_OF_PLAYERS) + 1;
         ++turn;
+        if (rRules.isEnabled() && !scoreManager.isGameOver()) {
+            drawn = rContext._M_drawDetector.isDraw(myBoard, currentPlayer);
+        }
     }
 
     if (scoreManager.isGameOver()) {
         // game is over with a result
         winner = scoreManager.getWinner();
-    } else if (turn >= MAX_NUM_OF_MOVES) {
-        // reached max number of turns without a result
+    } else {
+        // reached max number of turns without a result, or ended early as a draw by the rules
         winner = NO_PLAYER;
     }
+    if (pRecord != nullptr) {
+        pRecord->setWinner(winner);
+    }
     return winner;
 }
\ No newline at end of file
@@ -9,14 +9,58 @@
 #define __H_GAME_MANAGER_RPS
 
 #include "BoardRPS.h"
+#include "DrawDetector.h"
+#include "GameRecord.h"
 #include "MoveRPS.h"
 #include "PieceRPS.h"
 #include "PlayerAlgorithm.h"
 #include "PointRPS.h"
 #include "ScoreManager.h"
+#include "TimeControl.h"
 
 #include <memory>
+#include <vector>
 
+/**
+ * @brief The state of the games played by a single thread: the board, the score and the scratch vectors.
+ * It is reset when a game ends instead of constructed for every game, so the vectors keep their capacity and a
+ * thread doesn't allocate any of it again once it played its first game. Nothing of the players is kept between
+ * games (a plugin may be unloaded after its last game).
+ *
+ */
+struct game_context {
+    BoardRPS _M_board; // the game board
+    ScoreManager _M_scoreManager; // the score of the game
+    std::vector<std::unique_ptr<PiecePosition>> _M_initPositions[NUM_OF_PLAYERS]; // the initial positions of each player
+    std::vector<std::unique_ptr<FightInfo>> _M_fightsInfo; // the fights of the positioning
+    DrawDetector _M_drawDetector; // follows the positions of the game, reset when the turns start
+    PlayerClock _M_clocks[NUM_OF_PLAYERS]; // measures the calls to each player
+
+    // basic c'tor
+    game_context()
+        : _M_board(DIM_X, DIM_Y)
+    {
+    }
+    // prepares the context for a new game
+    void reset();
+};
+
+/**
+ * @brief The time control of a game: the budgets of the players, and the latencies of their calls.
+ *
+ */
+struct game_timing {
+    time_control _M_control; // the budgets of both players
+    latency_histogram _M_latency[NUM_OF_PLAYERS]; // the calls of each player are added to its histogram
+    const char* _M_ids[NUM_OF_PLAYERS] = {}; // the ids of the players' algorithms, reported on a hung call
+};
+
+/**
+ * @brief Plays RPS games. The manager itself holds no state, every game is played on the context of the
+ * calling thread, so any number of threads may play at once without sharing anything.
+ * NOTE: a game must not be started from within a game played by the same thread (e.g. by a player).
+ *
+ */
 class GameManager {
 private:
     static GameManager instance;
@@ -29,14 +73,19 @@ public:
     {
         return instance;
     }
-    // play the RPS game
-    int PlayRPS(std::unique_ptr<PlayerAlgorithm> p1, std::unique_ptr<PlayerAlgorithm> p2);
+    // play the RPS game, the game is recorded into pRecord if given and may end early as a draw by the rules,
+    // the players are timed if pTiming is given (and lose when over their budgets)
+    int PlayRPS(std::unique_ptr<PlayerAlgorithm> p1, std::unique_ptr<PlayerAlgorithm> p2, GameRecord* pRecord = nullptr,
+        const draw_rules& rRules = draw_rules(), game_timing* pTiming = nullptr);
 
 private:
+    // the context of the games played by the calling thread
+    static game_context& localContext();
     // fill the board with player pieces
     bool fillBoard(BoardRPS& rBoard, int vCurrPlayer, std::vector<std::unique_ptr<PiecePosition>>& positioningVec, std::vector<std::unique_ptr<FightInfo>>& rpFightInfoVec, ScoreManager& rScoreManager);
     // play a turn for a player
-    void playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgorithm>& rpCurrPlayer, std::unique_ptr<PlayerAlgorithm>& rpOppPlayer, BoardRPS& myBoard, ScoreManager& rScoreManager);
+    void playCurrTurn(int currPlayerNumber, std::unique_ptr<PlayerAlgorithm>& rpCurrPlayer, std::unique_ptr<PlayerAlgorithm>& rpOppPlayer, BoardRPS& myBoard, ScoreManager& rScoreManager, GameRecord* pRecord,
+        PlayerClock& rCurrClock, PlayerClock& rOppClock);
 };
 
 #endif // !__H_GAME_MANAGER_RPS
\ No newline at end of file
@@ -0,0 +1,419 @@
+/**
+ * @brief The implementation file of the GameRecord class.
+ *
+ * @file GameRecord.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#include "GameRecord.h"
+#include "Point.h"
+
+// a position outside of the board, followed by the zigzag varint coordinates
+#define POINT_ESCAPE 0xFF
+
+// turn tag bits
+#define TURN_KIND_MASK 0x03
+#define TURN_SKIP 0 // no move, the turn is skipped
+#define TURN_STEP 1 // a single step move, the direction is in the tag
+#define TURN_JUMP 2 // any other move, the destination follows the origin
+#define TURN_DIRECTION_SHIFT 2
+#define TURN_JOKER_CHANGE 0x10
+#define TURN_DISMISSED 0x20
+#define TURN_FIGHT_SHIFT 6 // 0 : no fight, otherwise the fight winner + 1
+
+// the single step directions, indexed by the direction in the tag
+static const int stepDx[] = { 1, -1, 0, 0 };
+static const int stepDy[] = { 0, 0, 1, -1 };
+
+/**
+ * @brief Appends an unsigned varint (7 bits per byte, low bits first).
+ *
+ * @param rBuffer - the buffer to append to
+ * @param value - the value to append
+ */
+static void writeVarint(std::vector<std::uint8_t>& rBuffer, std::uint32_t value)
+{
+    while (value >= 0x80) {
+        rBuffer.push_back((std::uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    rBuffer.push_back((std::uint8_t)value);
+}
+
+/**
+ * @brief Gets the number of bytes of a varint.
+ *
+ * @param value - the value
+ * @return std::uint32_t - the number of bytes writeVarint appends for the value
+ */
+static std::uint32_t varintSize(std::uint32_t value)
+{
+    std::uint32_t size = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/**
+ * @brief Appends a position. Positions on the board take a single byte.
+ *
+ * @param rBuffer - the buffer to append to
+ * @param x - the X coordinate
+ * @param y - the Y coordinate
+ */
+static void writePoint(std::vector<std::uint8_t>& rBuffer, int x, int y)
+{
+    if (x > 0 && x <= DIM_X && y > 0 && y <= DIM_Y) {
+        rBuffer.push_back((std::uint8_t)((y - 1) * DIM_X + (x - 1)));
+        return;
+    }
+    // zigzag encoding, so small negative values stay small
+    rBuffer.push_back(POINT_ESCAPE);
+    writeVarint(rBuffer, ((std::uint32_t)x << 1) ^ (std::uint32_t)(x >> 31));
+    writeVarint(rBuffer, ((std::uint32_t)y << 1) ^ (std::uint32_t)(y >> 31));
+}
+
+/**
+ * @brief Reads a position written by writePoint.
+ *
+ * @param rpData - the read pointer, advanced past the position
+ * @param pEnd - the end of the data
+ * @param rX - filled with the X coordinate
+ * @param rY - filled with the Y coordinate
+ * @return true - if the position was read
+ * @return false - if the data is malformed
+ */
+static bool readPoint(const std::uint8_t*& rpData, const std::uint8_t* pEnd, int& rX, int& rY)
+{
+    std::uint32_t x, y;
+
+    if (rpData >= pEnd) {
+        return false;
+    }
+    if (*rpData != POINT_ESCAPE) {
+        rX = *rpData % DIM_X + 1;
+        rY = *rpData / DIM_X + 1;
+        ++rpData;
+        return true;
+    }
+    ++rpData;
+    if (!GameRecord::readVarint(rpData, pEnd, x) || !GameRecord::readVarint(rpData, pEnd, y)) {
+        return false;
+    }
+    rX = (int)(x >> 1) ^ -(int)(x & 1);
+    rY = (int)(y >> 1) ^ -(int)(y & 1);
+    return true;
+}
+
+/**
+ * @brief Reads a length prefixed block of bytes.
+ *
+ * @param rpData - the read pointer, advanced past the block
+ * @param pEnd - the end of the data
+ * @param rpBlock - set to the start of the block
+ * @param rSize - set to the size of the block
+ * @return true - if the block was read
+ * @return false - if the data is malformed
+ */
+static bool readBlock(const std::uint8_t*& rpData, const std::uint8_t* pEnd, const std::uint8_t*& rpBlock, std::uint32_t& rSize)
+{
+    if (!GameRecord::readVarint(rpData, pEnd, rSize) || (std::size_t)(pEnd - rpData) < rSize) {
+        return false;
+    }
+    rpBlock = rpData;
+    rpData += rSize;
+    return true;
+}
+
+GameRecord::GameRecord()
+{
+    clear();
+}
+
+/**
+ * @brief Clears the record. The buffers keep their capacity, so a reused record doesn't allocate.
+ *
+ */
+void GameRecord::clear()
+{
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        _ids[i].clear();
+        _placements[i].clear();
+        _numOfPlacements[i] = 0;
+    }
+    _turns.clear();
+    _numOfTurns = 0;
+    _winner = NO_PLAYER;
+}
+
+/**
+ * @brief Sets the ids of the players.
+ *
+ * @param id_p1 - the id of player 1
+ * @param id_p2 - the id of player 2
+ */
+void GameRecord::setPlayers(const std::string& id_p1, const std::string& id_p2)
+{
+    _ids[PLAYER_1 - 1] = id_p1;
+    _ids[PLAYER_2 - 1] = id_p2;
+}
+
+/**
+ * @brief Records the initial positions of a player, exactly as given by the player (including bad ones).
+ *
+ * @param player - the player
+ * @param positions - the positions the player returned
+ */
+void GameRecord::addPlacements(int player, const std::vector<std::unique_ptr<PiecePosition>>& positions)
+{
+    std::vector<std::uint8_t>& rBuffer = _placements[player - 1];
+
+    for (auto& position : positions) {
+        writePoint(rBuffer, position->getPosition().getX(), position->getPosition().getY());
+        rBuffer.push_back((std::uint8_t)position->getPiece());
+        if (position->getPiece() == JOKER_CHR) {
+            rBuffer.push_back((std::uint8_t)position->getJokerRep());
+        }
+    }
+    _numOfPlacements[player - 1] += (int)positions.size();
+}
+
+/**
+ * @brief Records the next turn. The player of the turn is implied by the turn index.
+ *
+ * @param pMove - the move of the player, null if the turn was skipped
+ * @param pFightInfo - the fight caused by the move, null if there was none
+ * @param pJokerChange - the requested joker change, null if there was none
+ * @param dismissed - true if the player lost on this turn
+ */
+void GameRecord::addTurn(const Move* pMove, const FightInfo* pFightInfo, const JokerChange* pJokerChange, bool dismissed)
+{
+    std::uint8_t tag = TURN_SKIP;
+    int direction = -1;
+    int dx = 0, dy = 0;
+    std::size_t tagIndex = _turns.size();
+
+    ++_numOfTurns;
+    _turns.push_back(tag);
+    if (pMove != nullptr) {
+        dx = pMove->getTo().getX() - pMove->getFrom().getX();
+        dy = pMove->getTo().getY() - pMove->getFrom().getY();
+        for (int d = 0; d < 4; ++d) {
+            if (stepDx[d] == dx && stepDy[d] == dy) {
+                direction = d;
+            }
+        }
+        writePoint(_turns, pMove->getFrom().getX(), pMove->getFrom().getY());
+        if (direction >= 0) {
+            tag = TURN_STEP | (std::uint8_t)(direction << TURN_DIRECTION_SHIFT);
+        } else {
+            tag = TURN_JUMP;
+            writePoint(_turns, pMove->getTo().getX(), pMove->getTo().getY());
+        }
+    }
+    if (pFightInfo != nullptr) {
+        tag |= (std::uint8_t)((pFightInfo->getWinner() + 1) << TURN_FIGHT_SHIFT);
+    }
+    if (pJokerChange != nullptr) {
+        tag |= TURN_JOKER_CHANGE;
+        writePoint(_turns, pJokerChange->getJokerChangePosition().getX(), pJokerChange->getJokerChangePosition().getY());
+        _turns.push_back((std::uint8_t)pJokerChange->getJokerNewRep());
+    }
+    if (dismissed) {
+        tag |= TURN_DISMISSED;
+    }
+    _turns[tagIndex] = tag;
+}
+
+/**
+ * @brief Decodes the placements of a player.
+ *
+ * @param player - the player
+ * @param rPlacements - filled with the placements (cleared first)
+ * @return true - if all the placements were decoded
+ * @return false - if the record is malformed
+ */
+bool GameRecord::readPlacements(int player, std::vector<record_placement>& rPlacements) const
+{
+    const std::vector<std::uint8_t>& buffer = _placements[player - 1];
+    const std::uint8_t* pData = buffer.data();
+    const std::uint8_t* pEnd = pData + buffer.size();
+    record_placement placement;
+
+    rPlacements.clear();
+    for (int i = 0; i < _numOfPlacements[player - 1]; ++i) {
+        if (!readPoint(pData, pEnd, placement._M_x, placement._M_y) || pData >= pEnd) {
+            return false;
+        }
+        placement._M_piece = (char)*pData++;
+        placement._M_joker_rep = NON_JOKER_CHR;
+        if (placement._M_piece == JOKER_CHR) {
+            if (pData >= pEnd) {
+                return false;
+            }
+            placement._M_joker_rep = (char)*pData++;
+        }
+        rPlacements.push_back(placement);
+    }
+    return pData == pEnd;
+}
+
+/**
+ * @brief Decodes all the turns of the game.
+ *
+ * @param rTurns - filled with the turns (cleared first)
+ * @return true - if all the turns were decoded
+ * @return false - if the record is malformed
+ */
+bool GameRecord::readTurns(std::vector<record_turn>& rTurns) const
+{
+    const std::uint8_t* pData = _turns.data();
+    const std::uint8_t* pEnd = pData + _turns.size();
+    record_turn turn;
+    std::uint8_t tag;
+    int direction;
+
+    rTurns.clear();
+    for (int i = 0; i < _numOfTurns; ++i) {
+        if (pData >= pEnd) {
+            return false;
+        }
+        tag = *pData++;
+        turn = record_turn();
+        turn._M_player = i % NUM_OF_PLAYERS + 1;
+        turn._M_has_move = (tag & TURN_KIND_MASK) != TURN_SKIP;
+        if (turn._M_has_move && !readPoint(pData, pEnd, turn._M_from_x, turn._M_from_y)) {
+            return false;
+        }
+        switch (tag & TURN_KIND_MASK) {
+        case TURN_STEP:
+            direction = (tag >> TURN_DIRECTION_SHIFT) & 0x03;
+            turn._M_to_x = turn._M_from_x + stepDx[direction];
+            turn._M_to_y = turn._M_from_y + stepDy[direction];
+            break;
+        case TURN_JUMP:
+            if (!readPoint(pData, pEnd, turn._M_to_x, turn._M_to_y)) {
+                return false;
+            }
+            break;
+        case TURN_SKIP:
+            break;
+        default:
+            return false;
+        }
+        turn._M_fight_winner = (tag >> TURN_FIGHT_SHIFT) == 0 ? GAME_IS_STILL_ON : (tag >> TURN_FIGHT_SHIFT) - 1;
+        turn._M_has_joker_change = (tag & TURN_JOKER_CHANGE) != 0;
+        if (turn._M_has_joker_change) {
+            if (!readPoint(pData, pEnd, turn._M_joker_x, turn._M_joker_y) || pData >= pEnd) {
+                return false;
+            }
+            turn._M_joker_rep = (char)*pData++;
+        }
+        turn._M_dismissed = (tag & TURN_DISMISSED) != 0;
+        rTurns.push_back(turn);
+    }
+    return pData == pEnd;
+}
+
+/**
+ * @brief Appends the game to the buffer, prefixed by the length of its body so readers can skip it.
+ *
+ * @param rBuffer - the buffer to append to
+ */
+void GameRecord::encode(std::vector<std::uint8_t>& rBuffer) const
+{
+    // the body size: the winner, the number of turns, then each block with its prefixes
+    std::uint32_t size = 1 + varintSize((std::uint32_t)_numOfTurns);
+
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        size += varintSize((std::uint32_t)_ids[i].size()) + (std::uint32_t)_ids[i].size();
+        size += varintSize((std::uint32_t)_numOfPlacements[i]);
+        size += varintSize((std::uint32_t)_placements[i].size()) + (std::uint32_t)_placements[i].size();
+    }
+    size += varintSize((std::uint32_t)_turns.size()) + (std::uint32_t)_turns.size();
+
+    writeVarint(rBuffer, size);
+    rBuffer.push_back((std::uint8_t)_winner);
+    writeVarint(rBuffer, (std::uint32_t)_numOfTurns);
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        writeVarint(rBuffer, (std::uint32_t)_ids[i].size());
+        rBuffer.insert(rBuffer.end(), _ids[i].begin(), _ids[i].end());
+    }
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        writeVarint(rBuffer, (std::uint32_t)_numOfPlacements[i]);
+        writeVarint(rBuffer, (std::uint32_t)_placements[i].size());
+        rBuffer.insert(rBuffer.end(), _placements[i].begin(), _placements[i].end());
+    }
+    writeVarint(rBuffer, (std::uint32_t)_turns.size());
+    rBuffer.insert(rBuffer.end(), _turns.begin(), _turns.end());
+}
+
+/**
+ * @brief Decodes a game body (without the length prefix) into this record.
+ *
+ * @param pData - the start of the body
+ * @param size - the size of the body
+ * @return true - if the body was decoded
+ * @return false - if the body is malformed (the record is left cleared)
+ */
+bool GameRecord::decode(const std::uint8_t* pData, std::size_t size)
+{
+    const std::uint8_t* pEnd = pData + size;
+    const std::uint8_t* pBlock;
+    std::uint32_t value, blockSize;
+
+    clear();
+    if (size < 1 || *pData > PLAYER_2) {
+        return false;
+    }
+    _winner = *pData++;
+    if (!readVarint(pData, pEnd, value)) {
+        return false;
+    }
+    _numOfTurns = (int)value;
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        if (!readBlock(pData, pEnd, pBlock, blockSize)) {
+            clear();
+            return false;
+        }
+        _ids[i].assign((const char*)pBlock, blockSize);
+    }
+    for (int i = 0; i < NUM_OF_PLAYERS; ++i) {
+        if (!readVarint(pData, pEnd, value) || !readBlock(pData, pEnd, pBlock, blockSize)) {
+            clear();
+            return false;
+        }
+        _numOfPlacements[i] = (int)value;
+        _placements[i].assign(pBlock, pBlock + blockSize);
+    }
+    if (!readBlock(pData, pEnd, pBlock, blockSize) || pData != pEnd) {
+        clear();
+        return false;
+    }
+    _turns.assign(pBlock, pBlock + blockSize);
+    return true;
+}
+
+/**
+ * @brief Reads an unsigned varint (at most 5 bytes).
+ *
+ * @param rpData - the read pointer, advanced past the varint
+ * @param pEnd - the end of the data
+ * @param rValue - filled with the value
+ * @return true - if the varint was read
+ * @return false - if the data is malformed
+ */
+/*static*/ bool GameRecord::readVarint(const std::uint8_t*& rpData, const std::uint8_t* pEnd, std::uint32_t& rValue)
+{
+    rValue = 0;
+    for (int shift = 0; shift < 35 && rpData < pEnd; shift += 7) {
+        rValue |= (std::uint32_t)(*rpData & 0x7F) << shift;
+        if ((*rpData++ & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
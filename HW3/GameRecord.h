@@ -0,0 +1,127 @@
+/**
+ * @brief The header file of the GameRecord class.
+ *
+ * @file GameRecord.h
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#ifndef __H_GAME_RECORD
+#define __H_GAME_RECORD
+
+#include "FightInfo.h"
+#include "GameUtilitiesRPS.h"
+#include "JokerChange.h"
+#include "Move.h"
+#include "PiecePosition.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// record file related
+#define RECORD_MAGIC "RPSG"
+#define RECORD_VERSION 1
+#define RECORD_FILE_SUFFIX ".rpsrec"
+
+/**
+ * @brief The header of a record file, followed by the encoded games.
+ *
+ */
+struct record_file_header {
+    char _M_magic[4];
+    std::uint8_t _M_version;
+    std::uint8_t _M_dim_x;
+    std::uint8_t _M_dim_y;
+    std::uint8_t _M_reserved;
+    std::uint32_t _M_max_repetitions; // the draw rules the games were played by (0 if disabled)
+    std::uint32_t _M_max_turns_without_fight;
+};
+
+/**
+ * @brief A single initial placement of a piece, as returned by the player.
+ *
+ */
+struct record_placement {
+    int _M_x;
+    int _M_y;
+    char _M_piece; // R, P, S, B, J or F (or whatever the player gave)
+    char _M_joker_rep; // the joker representation, '#' for non-joker pieces
+};
+
+/**
+ * @brief A single turn of the game, as played by the game manager.
+ *
+ */
+struct record_turn {
+    int _M_player; // the player of the turn
+    bool _M_has_move; // false if the player had no more moves (turn skipped)
+    int _M_from_x;
+    int _M_from_y;
+    int _M_to_x;
+    int _M_to_y;
+    int _M_fight_winner; // the winner of the fight caused by the move, GAME_IS_STILL_ON if there was no fight
+    bool _M_has_joker_change; // true if the player requested a joker change
+    int _M_joker_x;
+    int _M_joker_y;
+    char _M_joker_rep;
+    bool _M_dismissed; // true if the player lost on this turn (bad move or bad joker change, or on time for a skipped turn)
+};
+
+/**
+ * @brief The compact binary record of a single game: the ids of the players, the initial placements
+ * of both players, one record per turn and the winner.
+ * Placements and turns are kept encoded, a turn is usually 2 bytes: a tag byte (kind of move, direction
+ * of a single step move, fight result, joker change and dismissal bits) and the combined origin position.
+ *
+ * Game layout (as written to a record file): varint body length, then the body - winner, varint number of turns,
+ * the player ids (varint length + bytes), for each player a varint count of placements and the placements, then the turns.
+ */
+class GameRecord {
+private:
+    std::string _ids[NUM_OF_PLAYERS]; // the ids of the players (may be empty)
+    std::vector<std::uint8_t> _placements[NUM_OF_PLAYERS]; // the encoded placements of each player
+    int _numOfPlacements[NUM_OF_PLAYERS]; // the number of placements of each player
+    std::vector<std::uint8_t> _turns; // the encoded turns
+    int _numOfTurns; // the number of turns
+    int _winner; // the winner of the game
+
+public:
+    // basic c'tor, an empty record
+    GameRecord();
+
+    // clears the record to be reused (keeps the allocated buffers)
+    void clear();
+
+    // recording
+    // sets the ids of the players
+    void setPlayers(const std::string& id_p1, const std::string& id_p2);
+    // records the initial placements of a player
+    void addPlacements(int player, const std::vector<std::unique_ptr<PiecePosition>>& positions);
+    // records a turn, any of the pointers may be null
+    void addTurn(const Move* pMove, const FightInfo* pFightInfo, const JokerChange* pJokerChange, bool dismissed);
+    // sets the winner of the game
+    void setWinner(int winner) { _winner = winner; }
+
+    // getters
+    const std::string& getPlayerId(int player) const { return _ids[player - 1]; }
+    int getNumOfPlacements(int player) const { return _numOfPlacements[player - 1]; }
+    int getNumOfTurns() const { return _numOfTurns; }
+    int getWinner() const { return _winner; }
+    // decodes the placements of a player into the vector
+    bool readPlacements(int player, std::vector<record_placement>& rPlacements) const;
+    // decodes all the turns into the vector (the turn index is the vector index)
+    bool readTurns(std::vector<record_turn>& rTurns) const;
+
+    // serialization
+    // appends the encoded game (length prefixed) to the buffer
+    void encode(std::vector<std::uint8_t>& rBuffer) const;
+    // decodes a game body of the given size, false if it is malformed
+    bool decode(const std::uint8_t* pData, std::size_t size);
+
+    // reads a varint at the pointer (not passing the end), false if malformed
+    static bool readVarint(const std::uint8_t*& rpData, const std::uint8_t* pEnd, std::uint32_t& rValue);
+};
+
+#endif // !__H_GAME_RECORD
@@ -0,0 +1,125 @@
+/**
+ * @brief The implementation file of the GameRecordReader class.
+ *
+ * @file GameRecordReader.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#include "GameRecordReader.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+GameRecordReader::GameRecordReader()
+    : _mapping(nullptr)
+    , _mappingSize(0)
+    , _nextGame(0)
+{
+}
+
+GameRecordReader::~GameRecordReader()
+{
+    close();
+}
+
+/**
+ * @brief Maps a record file into memory, validates its header and builds the index of its games.
+ *
+ * @param path - the path of the record file
+ * @return true - if the file is a record file of the current game settings
+ * @return false - otherwise (the reader is left closed)
+ */
+bool GameRecordReader::open(const char* path)
+{
+    struct stat st;
+    const record_file_header* pHeader;
+    const std::uint8_t* pData;
+    const std::uint8_t* pEnd;
+    std::uint32_t size;
+    int fd;
+
+    close();
+    fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(record_file_header)) {
+        ::close(fd);
+        return false;
+    }
+    _mappingSize = (std::size_t)st.st_size;
+    _mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (_mapping == MAP_FAILED) {
+        _mapping = nullptr;
+        _mappingSize = 0;
+        return false;
+    }
+
+    pHeader = static_cast<const record_file_header*>(_mapping);
+    if (std::memcmp(pHeader->_M_magic, RECORD_MAGIC, sizeof(pHeader->_M_magic)) != 0 || pHeader->_M_version != RECORD_VERSION
+        || pHeader->_M_dim_x != DIM_X || pHeader->_M_dim_y != DIM_Y) {
+        // not a record file, or a record of a different game setting
+        close();
+        return false;
+    }
+    _drawRules._M_maxRepetitions = (int)pHeader->_M_max_repetitions;
+    _drawRules._M_maxTurnsWithoutFight = (int)pHeader->_M_max_turns_without_fight;
+    // the games are read sequentially, skipping the bodies by their length
+    pData = static_cast<const std::uint8_t*>(_mapping) + sizeof(record_file_header);
+    pEnd = static_cast<const std::uint8_t*>(_mapping) + _mappingSize;
+    while (pData < pEnd && GameRecord::readVarint(pData, pEnd, size) && (std::size_t)(pEnd - pData) >= size) {
+        _offsets.push_back((std::size_t)(pData - static_cast<const std::uint8_t*>(_mapping)));
+        _sizes.push_back(size);
+        pData += size;
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the file and clears the index.
+ *
+ */
+void GameRecordReader::close()
+{
+    if (_mapping != nullptr) {
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _offsets.clear();
+    _sizes.clear();
+    _nextGame = 0;
+}
+
+/**
+ * @brief Reads a game by its index in the file.
+ *
+ * @param index - the index of the game
+ * @param rRecord - filled with the game
+ * @return true - if the game was read
+ * @return false - if the index is out of range or the game is malformed
+ */
+bool GameRecordReader::read(int index, GameRecord& rRecord) const
+{
+    if (index < 0 || index >= size()) {
+        return false;
+    }
+    return rRecord.decode(static_cast<const std::uint8_t*>(_mapping) + _offsets[index], _sizes[index]);
+}
+
+/**
+ * @brief Reads the next game in the file.
+ *
+ * @param rRecord - filled with the game
+ * @return true - if a game was read
+ * @return false - at the end of the file, or if the game is malformed
+ */
+bool GameRecordReader::next(GameRecord& rRecord)
+{
+    return read(_nextGame++, rRecord);
+}
@@ -0,0 +1,65 @@
+/**
+ * @brief The header file of the GameRecordReader class.
+ *
+ * @file GameRecordReader.h
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#ifndef __H_GAME_RECORD_READER
+#define __H_GAME_RECORD_READER
+
+#include "DrawDetector.h"
+#include "GameRecord.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A reader of a record file written by GameRecordWriter.
+ * The file is memory mapped on open and indexed (the offset of every game), so games can be read in order
+ * or by index. A truncated last game (a file of an interrupted tournament) is ignored.
+ *
+ */
+class GameRecordReader {
+private:
+    void* _mapping; // the memory mapped file (nullptr if not open)
+    std::size_t _mappingSize; // the size of the mapped region
+    std::vector<std::size_t> _offsets; // the offset of the body of each game
+    std::vector<std::size_t> _sizes; // the size of the body of each game
+    int _nextGame; // the index of the next game read by next()
+    draw_rules _drawRules; // the draw rules the games of the file were played by
+
+public:
+    // basic c'tor, no file is open
+    GameRecordReader();
+    // no need for copy c'tor
+    GameRecordReader(const GameRecordReader& other) = delete;
+    // d'tor
+    ~GameRecordReader();
+
+    // no need for copy assignment
+    GameRecordReader& operator=(const GameRecordReader& other) = delete;
+
+    // opens and indexes a record file, false if it isn't a valid record file
+    bool open(const char* path);
+    // closes the file
+    void close();
+    // true iff a file is open
+    bool isOpen() const { return _mapping != nullptr; }
+    // the number of games in the file
+    int size() const { return (int)_offsets.size(); }
+    // the size of the file in bytes
+    std::size_t getFileSize() const { return _mappingSize; }
+    // the draw rules the games of the file were played by
+    const draw_rules& getDrawRules() const { return _drawRules; }
+
+    // reads the game at index into the record, false if the game is malformed
+    bool read(int index, GameRecord& rRecord) const;
+    // moves the position of next() to the game at index
+    void seek(int index) { _nextGame = index; }
+    // reads the next game, false at the end of the file or if the game is malformed
+    bool next(GameRecord& rRecord);
+};
+
+#endif // !__H_GAME_RECORD_READER
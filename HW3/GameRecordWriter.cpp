@@ -0,0 +1,158 @@
+/**
+ * @brief The implementation file of the GameRecordWriter class.
+ *
+ * @file GameRecordWriter.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#include "GameRecordWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+// initialization of the static members
+std::string GameRecordWriter::directory;
+draw_rules GameRecordWriter::drawRules;
+std::atomic<int> GameRecordWriter::nextFileIndex(0);
+std::atomic<int> GameRecordWriter::numOfGames(0);
+std::atomic<int> GameRecordWriter::numOfFailures(0);
+std::mutex GameRecordWriter::writersLock;
+std::vector<GameRecordWriter*> GameRecordWriter::writers;
+
+// the writer of each thread, destroyed (and flushed) when the thread exits
+static thread_local std::unique_ptr<GameRecordWriter> localWriter;
+
+/**
+ * @brief Construct a new Game Record Writer object. Opens the next record file of the directory and writes its header.
+ *
+ */
+GameRecordWriter::GameRecordWriter()
+    : _file(nullptr)
+{
+    std::string path = directory + "games_" + std::to_string(nextFileIndex++) + RECORD_FILE_SUFFIX;
+    record_file_header fileHeader;
+
+    _buffer.reserve(RECORD_BUFFER_SIZE);
+    _file = std::fopen(path.c_str(), "wb");
+    if (_file == nullptr) {
+        ++numOfFailures;
+        return;
+    }
+    std::memcpy(fileHeader._M_magic, RECORD_MAGIC, sizeof(fileHeader._M_magic));
+    fileHeader._M_version = RECORD_VERSION;
+    fileHeader._M_dim_x = DIM_X;
+    fileHeader._M_dim_y = DIM_Y;
+    fileHeader._M_reserved = 0;
+    fileHeader._M_max_repetitions = (std::uint32_t)drawRules._M_maxRepetitions;
+    fileHeader._M_max_turns_without_fight = (std::uint32_t)drawRules._M_maxTurnsWithoutFight;
+    _buffer.insert(_buffer.end(), (const std::uint8_t*)&fileHeader, (const std::uint8_t*)&fileHeader + sizeof(fileHeader));
+    std::lock_guard<std::mutex> lock(writersLock);
+    writers.push_back(this);
+}
+
+GameRecordWriter::~GameRecordWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(writersLock);
+        writers.erase(std::find(writers.begin(), writers.end(), this));
+    }
+    close();
+}
+
+/**
+ * @brief Enables the recording of games. Not thread safe, should be called before the games start.
+ *
+ * @param dir - the directory of the record files
+ * @param rRules - the draw rules of the games, so they are replayed by the same rules
+ */
+/*static*/ void GameRecordWriter::enable(const std::string& dir, const draw_rules& rRules)
+{
+    drawRules = rRules;
+    directory = dir;
+    if (!directory.empty() && directory.back() != '/') {
+        directory += "/";
+    }
+}
+
+/**
+ * @brief Gets the writer of the calling thread, opening its file on first use.
+ *
+ * @return GameRecordWriter& - the writer of the thread
+ */
+/*static*/ GameRecordWriter& GameRecordWriter::local()
+{
+    if (localWriter == nullptr) {
+        localWriter.reset(new GameRecordWriter());
+    }
+    return *localWriter;
+}
+
+/**
+ * @brief Writes and closes the writer of the calling thread. Threads that exit close their writer on their own,
+ * this is needed for the main thread before the process ends.
+ *
+ */
+/*static*/ void GameRecordWriter::closeLocal()
+{
+    localWriter.reset();
+}
+
+/**
+ * @brief Writes and closes the files of all the writers, so the games recorded so far are kept when the process
+ * is aborted (std::_Exit doesn't run the destructors). May be called from any thread, the writers stay open
+ * but ignore their next games.
+ *
+ */
+/*static*/ void GameRecordWriter::closeAll()
+{
+    std::lock_guard<std::mutex> lock(writersLock);
+    for (GameRecordWriter* pWriter : writers) {
+        pWriter->close();
+    }
+}
+
+/**
+ * @brief Appends a game. The game is buffered, the buffer is written once it is large enough.
+ *
+ * @param record - the game to write
+ */
+void GameRecordWriter::write(const GameRecord& record)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_file == nullptr) {
+        // closed (or never opened)
+        return;
+    }
+    record.encode(_buffer);
+    ++numOfGames;
+    if (_buffer.size() >= RECORD_BUFFER_SIZE) {
+        flush();
+    }
+}
+
+/**
+ * @brief Writes the buffered games to the file.
+ *
+ */
+void GameRecordWriter::flush()
+{
+    if (_file != nullptr && !_buffer.empty() && std::fwrite(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size()) {
+        ++numOfFailures;
+    }
+    _buffer.clear();
+}
+
+/**
+ * @brief Writes the buffered games and closes the file, once.
+ *
+ */
+void GameRecordWriter::close()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    flush();
+    if (_file != nullptr && std::fclose(_file) != 0) {
+        ++numOfFailures;
+    }
+    _file = nullptr;
+}
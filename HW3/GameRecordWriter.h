@@ -0,0 +1,82 @@
+/**
+ * @brief The header file of the GameRecordWriter class.
+ *
+ * @file GameRecordWriter.h
+ * @author Yotam Sechayk
+ * @date 2018-07-06
+ */
+#ifndef __H_GAME_RECORD_WRITER
+#define __H_GAME_RECORD_WRITER
+
+#include "DrawDetector.h"
+#include "GameRecord.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// the size of the buffer of a writer before it is written to the file
+#define RECORD_BUFFER_SIZE (64 * 1024)
+
+/**
+ * @brief A per-thread streaming writer of game records.
+ * Every thread that plays games gets its own writer and its own file (<directory>/games_<n>.rpsrec),
+ * so games are appended without any lock. Records are buffered and written in large chunks.
+ *
+ * File layout: a record_file_header (magic, version, board dimensions, draw rules), followed by the encoded games.
+ */
+class GameRecordWriter {
+private:
+    std::FILE* _file; // the record file (nullptr if it couldn't be opened)
+    std::vector<std::uint8_t> _buffer; // the encoded games not yet written
+    std::mutex _lock; // guards the writer against closeAll, never contended otherwise
+
+    static std::string directory; // the directory of the record files, empty when recording is disabled
+    static draw_rules drawRules; // the draw rules of the recorded games, written into the file headers
+    static std::atomic<int> nextFileIndex; // the index of the next record file
+    static std::atomic<int> numOfGames; // the number of games recorded by all the writers
+    static std::atomic<int> numOfFailures; // the number of failed writes of all the writers
+    static std::mutex writersLock; // guards the writers
+    static std::vector<GameRecordWriter*> writers; // the open writers of all the threads
+
+    // basic c'tor, opens the next record file
+    GameRecordWriter();
+
+public:
+    // no need for copy c'tor
+    GameRecordWriter(const GameRecordWriter& other) = delete;
+    // d'tor, writes the buffered games and closes the file
+    ~GameRecordWriter();
+
+    // no need for copy assignment
+    GameRecordWriter& operator=(const GameRecordWriter& other) = delete;
+
+    // enables recording into the directory, must be called before any game is played
+    static void enable(const std::string& dir, const draw_rules& rRules = draw_rules());
+    // true iff recording is enabled
+    static bool isEnabled() { return !directory.empty(); }
+    // gets the writer of the calling thread (opened on first use)
+    static GameRecordWriter& local();
+    // closes the writer of the calling thread, if it has one
+    static void closeLocal();
+    // writes and closes the files of all the writers (the writers then ignore their games), before an abort
+    static void closeAll();
+    // the number of games recorded so far (written, after closeAll)
+    static int getNumOfGames() { return numOfGames; }
+    // the number of failed writes so far
+    static int getNumOfFailures() { return numOfFailures; }
+
+    // appends a game to the file
+    void write(const GameRecord& record);
+
+private:
+    // writes the buffered games to the file
+    void flush();
+    // writes the buffered games and closes the file
+    void close();
+};
+
+#endif // !__H_GAME_RECORD_WRITER
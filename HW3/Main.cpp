@@ -5,12 +5,15 @@
  * @author Yotam Sechayk
  * @date 2018-06-07
  */
+#include "GameRecordWriter.h"
 #include "ThreadPool.h"
 #include "TournamentManager.h"
 
+#include <cstdlib>
 #include <dlfcn.h>
 #include <iostream>
 #include <list>
+#include <map>
 #include <random>
 #include <string.h>
 #include <string>
@@ -18,11 +21,48 @@
 
 // size of buffer for reading in directory entries
 #define BUF_SIZE 4097
-#define MSG_INVALID_FORMAT "Please call using the following format: <exe> [-path <.so directory path> [-threads <number>]]"
+#define MSG_INVALID_FORMAT "Please call using the following format: <exe> [-path <.so directory path> [-threads <number>]] [-record <records directory>]" \
+                           " [-repetitions <number>] [-no-fight-turns <number>] [-call-budget <ms>] [-game-budget <ms>] [-call-timeout <ms>] [-latency]"
 #define ERR_RETURN -1
 #define INF "[INFO] "
 #define ERR "[ERROR] "
 
+/**
+ * @brief Prints the latency report: the thread CPU time of the calls to each algorithm, with its histogram.
+ * 
+ * @param latencies - the latencies of each algorithm, nothing is printed if empty
+ */
+static void printLatencies(const std::map<std::string, latency_histogram>& latencies)
+{
+    if (latencies.empty()) {
+        return;
+    }
+    std::cout << INF << "Player call latencies (thread CPU time, microseconds):" << std::endl;
+    std::cout << "id\tcalls\tforfeits\tmean\tp50\tp99\tmax" << std::endl;
+    for (auto& rLatency : latencies) {
+        const latency_histogram& histogram = rLatency.second;
+        std::cout << rLatency.first << "\t" << histogram._M_calls << "\t" << histogram._M_forfeits << "\t"
+                  << (histogram._M_calls > 0 ? histogram._M_totalMicros / histogram._M_calls : 0) << "\t" << histogram.getPercentile(50) << "\t"
+                  << histogram.getPercentile(99) << "\t" << histogram._M_maxMicros << std::endl;
+    }
+    // the calls below each bucket limit (the last bucket is open ended)
+    std::cout << INF << "Player call latency histograms (number of calls under each limit):" << std::endl;
+    for (auto& rLatency : latencies) {
+        std::cout << rLatency.first;
+        for (int i = 0; i < NUM_OF_LATENCY_BUCKETS; ++i) {
+            if (rLatency.second._M_buckets[i] == 0) {
+                continue;
+            }
+            if (i == NUM_OF_LATENCY_BUCKETS - 1) {
+                std::cout << " >=" << latency_histogram::getBucketLimit(i - 1) << ":" << rLatency.second._M_buckets[i];
+            } else {
+                std::cout << " <" << latency_histogram::getBucketLimit(i) << ":" << rLatency.second._M_buckets[i];
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
 int main(int argc, char** argv)
 {
     FILE* dl; // handle to read directory
@@ -37,6 +77,16 @@ int main(int argc, char** argv)
     std::string soFilesDirectory("./");
     std::string path("-path");
     std::string threads("-threads");
+    std::string record("-record");
+    std::string recordDirectory;
+    std::string repetitions("-repetitions");
+    std::string noFightTurns("-no-fight-turns");
+    draw_rules drawRules;
+    std::string callBudget("-call-budget");
+    std::string gameBudget("-game-budget");
+    std::string callTimeout("-call-timeout");
+    std::string latency("-latency");
+    time_control timeControl;
 
     // set the seed for the randomization
     srand((unsigned)time(NULL));
@@ -68,9 +118,60 @@ int main(int argc, char** argv)
                 ;
                 return ERR_RETURN;
             }
+        } else if (record.compare(argv[i]) == 0) {
+            if (argc < i + 2) {
+                std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+                return ERR_RETURN;
+            }
+            // every playing thread writes its games into its own file in the directory
+            recordDirectory = argv[i + 1];
+        } else if (repetitions.compare(argv[i]) == 0 || noFightTurns.compare(argv[i]) == 0) {
+            if (argc < i + 2) {
+                std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+                return ERR_RETURN;
+            }
+            // a game ending as a draw when a position repeats, or when there was no fight for a number of turns
+            bool isRepetitions = repetitions.compare(argv[i]) == 0;
+            int& rRule = isRepetitions ? drawRules._M_maxRepetitions : drawRules._M_maxTurnsWithoutFight;
+            try {
+                rRule = std::stoi(argv[i + 1]);
+            } catch (...) {
+                rRule = -1;
+            }
+            // a position reached once isn't repeated
+            if (rRule < 0 || (isRepetitions && rRule == 1)) {
+                std::cout << ERR << "Please specify a valid number for '" << argv[i] << "' (0 to disable), '" << argv[i + 1] << "' is not a valid value." << std::endl;
+                return ERR_RETURN;
+            }
+        } else if (callBudget.compare(argv[i]) == 0 || gameBudget.compare(argv[i]) == 0 || callTimeout.compare(argv[i]) == 0) {
+            if (argc < i + 2) {
+                std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+                return ERR_RETURN;
+            }
+            // the CPU time a player may spend in a single call, or in all the calls of a game,
+            // or the wall clock time after which a call is hung
+            long& rBudget = callBudget.compare(argv[i]) == 0 ? timeControl._M_maxCallMicros
+                : gameBudget.compare(argv[i]) == 0           ? timeControl._M_maxGameMicros
+                                                             : timeControl._M_callTimeoutMicros;
+            try {
+                rBudget = std::stol(argv[i + 1]) * 1000;
+            } catch (...) {
+                rBudget = -1;
+            }
+            if (rBudget < 0) {
+                std::cout << ERR << "Please specify a valid number of milliseconds for '" << argv[i] << "' (0 to disable), '" << argv[i + 1] << "' is not a valid value." << std::endl;
+                return ERR_RETURN;
+            }
+        } else if (latency.compare(argv[i]) == 0) {
+            TournamentManager::get().enableLatencyReport();
         }
     }
 
+    if (!recordDirectory.empty()) {
+        // the draw rules are written into the record files, the games are replayed by them
+        GameRecordWriter::enable(recordDirectory, drawRules);
+    }
+
     std::cout << INF << "Using .so files in: '" << soFilesDirectory << "'." << std::endl;
 
     // command string to get dynamic lib names
@@ -132,12 +233,50 @@ int main(int argc, char** argv)
         return ERR_RETURN;
     }
 
+    // the same rules for all the games of the tournament
+    TournamentManager::get().setDrawRules(drawRules);
+    if (drawRules.isEnabled()) {
+        std::cout << INF << "Games end early as draws after " << drawRules._M_maxRepetitions << " repetitions of a position or "
+                  << drawRules._M_maxTurnsWithoutFight << " turns without a fight (0 is disabled)." << std::endl;
+    }
+
+    TournamentManager::get().setTimeControl(timeControl);
+    if (timeControl.isEnabled()) {
+        std::cout << INF << "Players lose on time after " << timeControl._M_maxCallMicros / 1000 << "ms of CPU time in a call or "
+                  << timeControl._M_maxGameMicros / 1000 << "ms in a game (0 is disabled)." << std::endl;
+        if (timeControl._M_callTimeoutMicros == 0) {
+            timeControl._M_callTimeoutMicros = WATCHDOG_DEFAULT_TIMEOUT_MS * 1000L;
+        }
+        std::cout << INF << "A call that doesn't return within " << timeControl._M_callTimeoutMicros / 1000 << "ms is hung." << std::endl;
+        // a hung call can't be stopped, and the tournament can't end without it, so it's aborted
+        // (the games recorded so far are written first)
+        Watchdog::start(timeControl._M_callTimeoutMicros, [](const char* id, const char* call, long wallMicros, long cpuMicros) {
+            std::cout << ERR << "Algorithm '" << id << "' hung in " << call << " (" << wallMicros / 1000 << "ms, "
+                      << cpuMicros / 1000 << "ms of CPU time), aborting the tournament." << std::endl;
+            if (GameRecordWriter::isEnabled()) {
+                GameRecordWriter::closeAll();
+                std::cout << INF << "Recorded " << GameRecordWriter::getNumOfGames() << " games before the abort." << std::endl;
+            }
+            std::_Exit(ERR_RETURN);
+        });
+    }
+
     // create the thread play pool (works with 0 or more additional threads)
     ThreadPool playPool(TournamentManager::get().getPlayQueue());
 
     // run the tournament wait for pool to finish
     playPool.run(numOfThreads - 1);
     playPool.waitForAll();
+    Watchdog::stop();
+
+    if (GameRecordWriter::isEnabled()) {
+        // the pool threads closed their writers when they exited, the main thread may have played too
+        GameRecordWriter::closeLocal();
+        std::cout << INF << "Recorded " << GameRecordWriter::getNumOfGames() << " games into '" << recordDirectory << "'." << std::endl;
+        if (GameRecordWriter::getNumOfFailures() > 0) {
+            std::cout << ERR << "Failed writing some of the game records." << std::endl;
+        }
+    }
 
     // get sorted final scores
     std::vector<std::pair<std::string, int>> finalScores;
@@ -148,6 +287,9 @@ int main(int argc, char** argv)
         std::cout << s.first << " " << s.second << std::endl;
     }
 
+    // print the latencies of the calls to the players, when measured
+    printLatencies(TournamentManager::get().getLatencies());
+
     // cleas algorithm registration before closing libs
     TournamentManager::get().clearAlgorithms();
 
@@ -0,0 +1,245 @@
+/**
+ * @brief The implementation file of the OpeningBook class.
+ *
+ * @file OpeningBook.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-02
+ */
+#include "OpeningBook.h"
+#include "PieceRPS.h"
+#include "PointRPS.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Construct a new Opening Book object. Maps the book file into memory and validates its header and all its entries,
+ * the entries are positioned as they are. If the file doesn't exist, doesn't match the current game settings
+ * or has an invalid entry (a corrupted book), the book is left empty.
+ *
+ * @param path - the path of the book file
+ */
+OpeningBook::OpeningBook(const char* path)
+    : _mapping(nullptr)
+    , _mappingSize(0)
+    , _entries(nullptr)
+    , _count(0)
+{
+    struct stat st;
+    const header* pHeader;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(header)) {
+        close(fd);
+        return;
+    }
+    _mappingSize = (std::size_t)st.st_size;
+    _mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    if (_mapping == MAP_FAILED) {
+        _mapping = nullptr;
+        return;
+    }
+
+    pHeader = static_cast<const header*>(_mapping);
+    if (std::memcmp(pHeader->_M_magic, BOOK_MAGIC, sizeof(pHeader->_M_magic)) != 0 || pHeader->_M_version != BOOK_VERSION
+        || pHeader->_M_dim_x != DIM_X || pHeader->_M_dim_y != DIM_Y || pHeader->_M_setup_size != SETUP_SIZE
+        || _mappingSize < sizeof(header) + (std::size_t)pHeader->_M_count * sizeof(OpeningSetup)) {
+        // not a book, or a book of a different game setting
+        unload();
+        return;
+    }
+    _entries = reinterpret_cast<const OpeningSetup*>(static_cast<const char*>(_mapping) + sizeof(header));
+    for (std::uint32_t i = 0; i < pHeader->_M_count; ++i) {
+        if (!isValid(_entries[i])) {
+            unload();
+            return;
+        }
+    }
+    _count = pHeader->_M_count;
+}
+
+OpeningBook::~OpeningBook()
+{
+    unload();
+}
+
+/**
+ * @brief Unmaps the book file and resets the book to be empty.
+ *
+ */
+void OpeningBook::unload()
+{
+    if (_mapping != nullptr) {
+        munmap(_mapping, _mappingSize);
+    }
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _entries = nullptr;
+    _count = 0;
+}
+
+/**
+ * @brief Gets a random entry of the book in O(1). The book is already filtered to the best setups, so they are sampled uniformly.
+ *
+ * The engine is owned by the caller, so players running on different threads never share a random state.
+ *
+ * @param rEngine - the random engine to draw the index from
+ * @return const OpeningSetup& - a reference to the entry inside the mapping
+ */
+const OpeningSetup& OpeningBook::sample(std::mt19937& rEngine) const
+{
+    std::uniform_int_distribution<std::uint32_t> index(0, _count - 1);
+    return _entries[index(rEngine)];
+}
+
+/**
+ * @brief Gets the type of the piece at the index in the canonical order (flags, bombs, jokers, rocks, papers, scissors).
+ *
+ * @param index - the index of the piece in a setup
+ * @return char - the piece char (J for jokers)
+ */
+/*static*/ char OpeningBook::getTypeAt(int index)
+{
+    const std::array<std::pair<char, int>, 6> order = { { { FLAG_CHR, FLAG_LIMIT }, { BOMB_CHR, BOMB_LIMIT }, { JOKER_CHR, JOKER_LIMIT }, { ROCK_CHR, ROCK_LIMIT }, { PAPER_CHR, PAPER_LIMIT }, { SCISSORS_CHR, SCISSORS_LIMIT } } };
+
+    for (auto& type : order) {
+        if (index < type.second) {
+            return type.first;
+        }
+        index -= type.second;
+    }
+    return UNKNOWN_CHR;
+}
+
+/**
+ * @brief Checks that a setup can be positioned as is: every position is on the board, no two pieces share a position,
+ * and every joker is represented by a rock, paper, scissors or bomb.
+ *
+ * @param setup - the setup to check
+ * @return true - iff the setup is valid
+ * @return false - otherwise
+ */
+/*static*/ bool OpeningBook::isValid(const OpeningSetup& setup)
+{
+    std::array<bool, DIM_X * DIM_Y> taken;
+
+    taken.fill(false);
+    for (std::uint8_t pos : setup._M_positions) {
+        if (pos >= DIM_X * DIM_Y || taken[pos]) {
+            return false;
+        }
+        taken[pos] = true;
+    }
+    for (char rep : setup._M_joker_reps) {
+        if (rep != ROCK_CHR && rep != PAPER_CHR && rep != SCISSORS_CHR && rep != BOMB_CHR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Builds a setup from a positioning vector. The positions are expected to be 1-based as in the game.
+ *
+ * @param positions - the positioning vector (as given by getInitialPositions)
+ * @param rSetup - the setup to fill
+ * @return true - iff the positioning has exactly the piece limits and makes a valid setup
+ * @return false - otherwise
+ */
+/*static*/ bool OpeningBook::toSetup(const std::vector<std::unique_ptr<PiecePosition>>& positions, OpeningSetup& rSetup)
+{
+    std::array<int, SETUP_SIZE> filled;
+    int x, y, joker;
+
+    if ((int)positions.size() != SETUP_SIZE) {
+        return false;
+    }
+    filled.fill(0);
+    for (auto& pPiece : positions) {
+        x = pPiece->getPosition().getX() - 1;
+        y = pPiece->getPosition().getY() - 1;
+        if (x < 0 || x >= DIM_X || y < 0 || y >= DIM_Y) {
+            return false;
+        }
+        // find the next free slot of the same type
+        int i = 0;
+        while (i < SETUP_SIZE && (getTypeAt(i) != pPiece->getPiece() || filled[i] != 0)) {
+            ++i;
+        }
+        if (i >= SETUP_SIZE) {
+            // too many pieces of this type
+            return false;
+        }
+        filled[i] = 1;
+        rSetup._M_positions[i] = (std::uint8_t)(y * DIM_X + x);
+        if (pPiece->getPiece() == JOKER_CHR) {
+            joker = i - FLAG_LIMIT - BOMB_LIMIT;
+            rSetup._M_joker_reps[joker] = pPiece->getJokerRep();
+        }
+    }
+    return isValid(rSetup);
+}
+
+/**
+ * @brief Fills a positioning vector from a setup.
+ *
+ * @param player - the player id of the positioned pieces
+ * @param setup - the setup to position
+ * @param vectorToFill - the vector to fill with the created pieces
+ */
+/*static*/ void OpeningBook::fromSetup(int player, const OpeningSetup& setup, std::vector<std::unique_ptr<PiecePosition>>& vectorToFill)
+{
+    char type;
+    bool isJoker;
+    int pos;
+
+    for (int i = 0; i < SETUP_SIZE; ++i) {
+        type = getTypeAt(i);
+        isJoker = type == JOKER_CHR;
+        if (isJoker) {
+            type = setup._M_joker_reps[i - FLAG_LIMIT - BOMB_LIMIT];
+        }
+        pos = setup._M_positions[i];
+        vectorToFill.push_back(std::make_unique<PieceRPS>(player, isJoker, type, PointRPS(pos % DIM_X + 1, pos / DIM_X + 1)));
+    }
+}
+
+/**
+ * @brief Writes a book file from the given setups.
+ *
+ * @param path - the path of the book file to (over)write
+ * @param setups - the entries of the book, in the order they will be written
+ * @return true - iff the file was written successfully
+ * @return false - otherwise
+ */
+/*static*/ bool OpeningBook::write(const char* path, const std::vector<OpeningSetup>& setups)
+{
+    header head;
+    std::ofstream out;
+
+    std::memcpy(head._M_magic, BOOK_MAGIC, sizeof(head._M_magic));
+    head._M_version = BOOK_VERSION;
+    head._M_dim_x = DIM_X;
+    head._M_dim_y = DIM_Y;
+    head._M_setup_size = SETUP_SIZE;
+    head._M_count = (std::uint32_t)setups.size();
+
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    out.write(reinterpret_cast<const char*>(setups.data()), setups.size() * sizeof(OpeningSetup));
+    out.close();
+    return !out.fail();
+}
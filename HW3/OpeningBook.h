@@ -0,0 +1,97 @@
+/**
+ * @brief The header file of the OpeningBook class.
+ *
+ * @file OpeningBook.h
+ * @author Yotam Sechayk
+ * @date 2018-07-02
+ */
+#ifndef __H_OPENING_BOOK
+#define __H_OPENING_BOOK
+
+#include "GameUtilitiesRPS.h"
+#include "PiecePosition.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// book file related
+#define BOOK_MAGIC "RPSB"
+#define BOOK_VERSION 1
+// the number of pieces in a single initial positioning
+#define SETUP_SIZE (FLAG_LIMIT + BOMB_LIMIT + JOKER_LIMIT + ROCK_LIMIT + PAPER_LIMIT + SCISSORS_LIMIT)
+
+/**
+ * @brief A single initial positioning of a player (an entry of the book).
+ * The pieces are kept in a canonical order: flags, bombs, jokers, rocks, papers and scissors,
+ * so only the (0-based, combined) position of each piece and the joker representations are stored.
+ *
+ */
+struct OpeningSetup {
+    std::array<std::uint8_t, SETUP_SIZE> _M_positions; // combined position (y * DIM_X + x) of each piece
+    std::array<char, JOKER_LIMIT> _M_joker_reps; // the representation of each joker
+};
+
+/**
+ * @brief A read-only opening book, a compact binary file of pre-scored initial positionings.
+ * The file is memory mapped on load and entries are sampled directly from the mapping.
+ *
+ * File layout: a fixed header (magic, version, board dimensions, setup size, entries count)
+ * followed by 'count' records of sizeof(OpeningSetup) bytes, best scored first.
+ */
+class OpeningBook {
+private:
+    // the on-disk header of the book
+    struct header {
+        char _M_magic[4];
+        std::uint8_t _M_version;
+        std::uint8_t _M_dim_x;
+        std::uint8_t _M_dim_y;
+        std::uint8_t _M_setup_size;
+        std::uint32_t _M_count;
+    };
+
+    void* _mapping; // the memory mapped file (nullptr if not loaded)
+    std::size_t _mappingSize; // the size of the mapped region
+    const OpeningSetup* _entries; // points into the mapping, right after the header
+    std::uint32_t _count; // the number of entries in the book
+
+public:
+    // basic c'tor (loads the book if the file exists and all its entries are valid)
+    explicit OpeningBook(const char* path);
+    // no need for copy c'tor
+    OpeningBook(const OpeningBook& other) = delete;
+    // d'tor
+    ~OpeningBook();
+
+    // no need for copy assignment
+    OpeningBook& operator=(const OpeningBook& other) = delete;
+
+    // true iff the book was loaded and has at least one entry
+    bool isLoaded() const { return _count > 0; }
+    // the number of entries in the book
+    int size() const { return (int)_count; }
+    // get an entry by index
+    const OpeningSetup& at(int index) const { return _entries[index]; }
+    // get a random entry from the book using the caller's engine (assumes the book is loaded)
+    const OpeningSetup& sample(std::mt19937& rEngine) const;
+
+    // writes a book file from the given setups (in the given order)
+    static bool write(const char* path, const std::vector<OpeningSetup>& setups);
+    // true iff the setup can be positioned: all the positions on the board and distinct, the joker representations legal
+    static bool isValid(const OpeningSetup& setup);
+    // builds a setup from a positioning vector (false if it doesn't match the piece limits)
+    static bool toSetup(const std::vector<std::unique_ptr<PiecePosition>>& positions, OpeningSetup& rSetup);
+    // fills a positioning vector from a setup for the given player
+    static void fromSetup(int player, const OpeningSetup& setup, std::vector<std::unique_ptr<PiecePosition>>& vectorToFill);
+    // gets the piece type of the piece at index in the canonical order
+    static char getTypeAt(int index);
+
+private:
+    // unmaps the book, if mapped
+    void unload();
+};
+
+#endif // !__H_OPENING_BOOK
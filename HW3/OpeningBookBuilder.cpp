@@ -0,0 +1,239 @@
+/**
+ * @brief The offline tool building the opening book of the RSPPlayer_312148190 algorithm.
+ * Random candidate setups are played against the player itself and against every reference
+ * algorithm found in the given directory, the best scored setups are written into the book.
+ *
+ * @file OpeningBookBuilder.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-02
+ */
+#include "GameManagerRPS.h"
+#include "OpeningBook.h"
+#include "RSPPlayer_312148190.h"
+#include "TournamentManager.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <iostream>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// size of buffer for reading in directory entries
+#define BUF_SIZE 4097
+#define MSG_INVALID_FORMAT "Please call using the following format: <exe> [-path <.so directory path>] [-candidates <number>] [-games <number>] [-keep <number>] [-threads <number>] [-out <book path>]"
+#define ERR_RETURN -1
+#define INF "[INFO] "
+#define ERR "[ERROR] "
+
+/**
+ * @brief The RSPPlayer_312148190 algorithm, positioning by a fixed setup (or randomly if none is given).
+ *
+ */
+class BookPlayer : public RSPPlayer_312148190 {
+private:
+    const OpeningSetup* _pSetup; // the setup to position by, nullptr for random positioning
+
+public:
+    explicit BookPlayer(const OpeningSetup* pSetup = nullptr)
+        : _pSetup(pSetup)
+    {
+    }
+
+    void getInitialPositions(int player, std::vector<unique_ptr<PiecePosition>>& vectorToFill)
+    {
+        if (_pSetup != nullptr) {
+            positionFromSetup(player, *_pSetup, vectorToFill);
+        } else {
+            positionRandomly(player, vectorToFill);
+        }
+    }
+};
+
+/**
+ * @brief Draws a setup uniformly from all the setups: the pieces are placed on distinct cells drawn from the whole
+ * board (a partial shuffle of the cells), and every joker gets a random representation. Unlike the player's own
+ * random positioning, no piece is kept in a fixed area, so the book may find any setup.
+ *
+ * @param rSetup - the setup to fill
+ */
+static void randomSetup(OpeningSetup& rSetup)
+{
+    const char reps[] = { ROCK_CHR, PAPER_CHR, SCISSORS_CHR, BOMB_CHR };
+    std::array<std::uint8_t, DIM_X * DIM_Y> cells;
+
+    for (int i = 0; i < DIM_X * DIM_Y; ++i) {
+        cells[i] = (std::uint8_t)i;
+    }
+    for (int i = 0; i < SETUP_SIZE; ++i) {
+        std::swap(cells[i], cells[i + std::rand() % (DIM_X * DIM_Y - i)]);
+        rSetup._M_positions[i] = cells[i];
+    }
+    for (auto& rRep : rSetup._M_joker_reps) {
+        rRep = reps[std::rand() % 4];
+    }
+}
+
+/**
+ * @brief Opens all the .so files in a directory, the algorithms register themselves into the TournamentManager.
+ *
+ * @param soFilesDirectory - the directory to look in
+ * @param dl_list - filled with the handles of the opened libs
+ */
+static void openReferenceAlgorithms(const std::string& soFilesDirectory, std::vector<void*>& dl_list)
+{
+    char in_buf[BUF_SIZE];
+    std::string command_str = "ls " + soFilesDirectory + "*.so 2>/dev/null";
+    FILE* dl = popen(command_str.c_str(), "r");
+    void* dlib;
+
+    if (!dl) {
+        return;
+    }
+    while (fgets(in_buf, BUF_SIZE, dl)) {
+        // trim off the whitespace at the end
+        char* ws = strpbrk(in_buf, " \t\n");
+        if (ws) {
+            *ws = '\0';
+        }
+        std::string name = (in_buf[0] == '/' || (in_buf[0] == '.' && in_buf[1] == '/')) ? in_buf : std::string("./") + in_buf;
+        dlib = dlopen(name.c_str(), RTLD_NOW);
+        if (dlib == NULL) {
+            std::cout << INF << "Error while attempting to open file: " << name << ", skipping it." << std::endl;
+            continue;
+        }
+        dl_list.push_back(dlib);
+    }
+    pclose(dl);
+}
+
+/**
+ * @brief Scores a setup by playing it as both players against every reference algorithm.
+ * Scoring is the same as in the tournament: 3 points for a win, 1 for a tie.
+ *
+ * @param setup - the setup to score
+ * @param refIds - the ids of the reference algorithms
+ * @param games - the number of games to play on each side against each reference
+ * @return int - the total score of the setup
+ */
+static int scoreSetup(const OpeningSetup& setup, const std::vector<std::string>& refIds, int games)
+{
+    int score = 0;
+    int winner;
+
+    for (auto& id : refIds) {
+        for (int i = 0; i < games; ++i) {
+            winner = GameManager::get().PlayRPS(std::make_unique<BookPlayer>(&setup), TournamentManager::get().getPlayer(id));
+            score += winner == PLAYER_1 ? 3 : (winner == NO_PLAYER ? 1 : 0);
+            winner = GameManager::get().PlayRPS(TournamentManager::get().getPlayer(id), std::make_unique<BookPlayer>(&setup));
+            score += winner == PLAYER_2 ? 3 : (winner == NO_PLAYER ? 1 : 0);
+        }
+    }
+    return score;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<void*> dl_list; // list to hold handles for dynamic libs
+    std::string soFilesDirectory("./");
+    std::string outPath("./RSPPlayer_312148190.book");
+    int numOfCandidates = 200;
+    int numOfGames = 5;
+    int numToKeep = 32;
+    int numOfThreads = 4;
+
+    // set the seed for the randomization
+    srand((unsigned)time(NULL));
+
+    // collect command line settings
+    for (int i = 1; i < argc; i += 2) {
+        std::string flag(argv[i]);
+        if (argc < i + 2) {
+            std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+            return ERR_RETURN;
+        }
+        if (flag.compare("-path") == 0) {
+            soFilesDirectory = argv[i + 1];
+            if (soFilesDirectory.at(soFilesDirectory.size() - 1) != '/') {
+                soFilesDirectory = soFilesDirectory + "/";
+            }
+            continue;
+        }
+        if (flag.compare("-out") == 0) {
+            outPath = argv[i + 1];
+            continue;
+        }
+        int* pValue = flag.compare("-candidates") == 0 ? &numOfCandidates : flag.compare("-games") == 0 ? &numOfGames : flag.compare("-keep") == 0 ? &numToKeep : flag.compare("-threads") == 0 ? &numOfThreads : nullptr;
+        if (pValue == nullptr) {
+            std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+            return ERR_RETURN;
+        }
+        try {
+            *pValue = std::stoi(argv[i + 1]);
+        } catch (...) {
+            *pValue = 0;
+        }
+        if (*pValue <= 0) {
+            std::cout << ERR << "Please specify a positive number for '" << flag << "', '" << argv[i + 1] << "' is not a valid value." << std::endl;
+            return ERR_RETURN;
+        }
+    }
+
+    // the player itself is linked in (and registered), other algorithms are taken from the directory
+    openReferenceAlgorithms(soFilesDirectory, dl_list);
+    std::vector<std::string> refIds = TournamentManager::get().getAlgorithmIds();
+
+    // generate the random candidates, spread over all the setups
+    std::vector<OpeningSetup> candidates(numOfCandidates);
+    for (auto& rSetup : candidates) {
+        randomSetup(rSetup);
+    }
+
+    std::cout << INF << "Scoring " << numOfCandidates << " setups against " << refIds.size() << " algorithms, using " << numOfThreads << " threads." << std::endl;
+
+    // score the candidates in parallel
+    std::vector<int> scores(candidates.size(), 0);
+    std::atomic<int> nextCandidate(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            int i;
+            while ((i = nextCandidate++) < (int)candidates.size()) {
+                scores[i] = scoreSetup(candidates[i], refIds, numOfGames);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // keep the best setups, best first
+    std::vector<int> order(candidates.size());
+    for (int i = 0; i < (int)order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
+    std::vector<OpeningSetup> book;
+    for (int i = 0; i < numToKeep && i < (int)order.size(); ++i) {
+        book.push_back(candidates[order[i]]);
+    }
+
+    int ret = 0;
+    if (!OpeningBook::write(outPath.c_str(), book)) {
+        std::cout << ERR << "Failed to write the book to '" << outPath << "'." << std::endl;
+        ret = ERR_RETURN;
+    } else {
+        std::cout << INF << "Wrote " << book.size() << " setups to '" << outPath << "', best score " << scores[order[0]] << " out of " << 6 * numOfGames * refIds.size() << "." << std::endl;
+    }
+
+    // clear algorithm registration before closing libs
+    TournamentManager::get().clearAlgorithms();
+    for (auto dlib : dl_list) {
+        dlclose(dlib);
+    }
+    return ret;
+}
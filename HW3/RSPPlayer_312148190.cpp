@@ -8,8 +8,22 @@
 #include "PieceRPS.h"
 #include "PointRPS.h"
 #include <algorithm>
+#include <fstream>
 #include <limits>
 #include <random>
+#include <string>
+
+// the opening book file, created offline by the rps_book tool
+#define OPENING_BOOK_PATH "./RSPPlayer_312148190.book"
+// the evaluation weights file, created offline by the rps_tune tool
+#define WEIGHTS_PATH "./RSPPlayer_312148190.weights"
+
+// move ordering keys, added to the history count of a move
+#define FLAG_CAPTURE_ORDER (1 << 28)
+#define FIGHT_ORDER (1 << 24)
+#define KILLER_ORDER (1 << 20)
+// when a history count reaches the limit all the counts are halved
+#define HISTORY_LIMIT (1 << 16)
 
 // %% INFO %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
@@ -133,7 +147,7 @@ void RSPPlayer_312148190::info::swapPieces(int pos1, int pos2)
  */
 void RSPPlayer_312148190::info::addMove(int from, int to)
 {
-    this->_M_moves.push_back({ from, to });
+    this->_M_moves.push({ from, to });
 }
 
 /**
@@ -143,7 +157,47 @@ void RSPPlayer_312148190::info::addMove(int from, int to)
  */
 const RSPPlayer_312148190::move& RSPPlayer_312148190::info::peekMove() const
 {
-    return this->_M_moves.back();
+    return this->_M_moves.get(0);
+}
+
+/**
+ * @brief Adds a move to the history. When the history is full the oldest move is overwritten.
+ * 
+ * @param vMove - the move to add
+ */
+void RSPPlayer_312148190::move_history::push(const RSPPlayer_312148190::move& vMove)
+{
+    this->_M_moves[this->_M_next] = vMove;
+    this->_M_next = (this->_M_next + 1) % MOVE_HISTORY_SIZE;
+    if (this->_M_size < MOVE_HISTORY_SIZE)
+        ++this->_M_size;
+}
+
+/**
+ * @brief Gets a move from the history by how many moves ago it was played. Assumes vPly is smaller than the history size.
+ * 
+ * @param vPly - the number of moves since (0 for the latest move)
+ * @return const RSPPlayer_312148190::move& - reference to the move
+ */
+const RSPPlayer_312148190::move& RSPPlayer_312148190::move_history::get(int vPly) const
+{
+    return this->_M_moves[(this->_M_next - 1 - vPly + MOVE_HISTORY_SIZE) % MOVE_HISTORY_SIZE];
+}
+
+/**
+ * @brief Counts the times a move appears in the history (the last MOVE_HISTORY_SIZE moves of both players).
+ * 
+ * @param vMove - the move to look for
+ * @return int - the number of repetitions
+ */
+int RSPPlayer_312148190::move_history::countRepetitions(const RSPPlayer_312148190::move& vMove) const
+{
+    int count = 0;
+    for (int i = 0; i < this->_M_size; ++i) {
+        if (this->_M_moves[i]._M_from == vMove._M_from && this->_M_moves[i]._M_to == vMove._M_to)
+            ++count;
+    }
+    return count;
 }
 
 // %% GENERAL %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -339,6 +393,70 @@ void RSPPlayer_312148190::positionPiecesOfType(int vLimit,
     }
 }
 
+/**
+ * @brief Positions all the pieces of the player by a setup taken from the opening book.
+ * 
+ * @param player - int representation of current player
+ * @param setup - the setup to position by
+ * @param vectorToFill - The function fills the vector with the created pieces
+ */
+void RSPPlayer_312148190::positionFromSetup(int player, const OpeningSetup& setup, std::vector<unique_ptr<PiecePosition>>& vectorToFill)
+{
+    char vType;
+    bool vIsJoker;
+
+    this->_info._M_this_player._M_id = player;
+    OpeningBook::fromSetup(player, setup, vectorToFill);
+    for (int i = 0; i < SETUP_SIZE; ++i) {
+        vType = OpeningBook::getTypeAt(i);
+        vIsJoker = vType == JOKER_CHR;
+        if (vIsJoker) {
+            vType = setup._M_joker_reps[i - FLAG_LIMIT - BOMB_LIMIT];
+        }
+        this->_info.addPiece({ this->_info._M_this_player._M_id, vIsJoker, vType }, setup._M_positions[i]);
+    }
+}
+
+/**
+ * @brief Gets the opening book of the player. The book is mapped once per process and shared (read-only) by all the instances.
+ * 
+ * @return const OpeningBook& - the book, empty if no book file was found
+ */
+/*static*/ const OpeningBook& RSPPlayer_312148190::getOpeningBook()
+{
+    static const OpeningBook book(OPENING_BOOK_PATH);
+    return book;
+}
+
+/**
+ * @brief Fills vectorToFill with random initial positions of the player.
+ * Implemented with Smart Random method, which spreads the pices randomly.
+ * It will not place two pieces in the same spot.
+ * 
+ * @param player - int representation of current player  
+ * @param vectorToFill - the vector sepcified above to be filled
+ */
+void RSPPlayer_312148190::positionRandomly(int player, std::vector<unique_ptr<PiecePosition>>& vectorToFill)
+{
+    // set the player number
+    this->_info._M_this_player._M_id = player;
+
+    // position the flag and bombs (1 and 2 respectively)
+    positionInitial(vectorToFill);
+    // insert remaining flags if exist
+    positionPiecesOfType(FLAG_LIMIT - 1, FLAG_CHR, vectorToFill);
+    // insert remaining bombs if exist
+    positionPiecesOfType(BOMB_LIMIT - 2, BOMB_CHR, vectorToFill);
+    // insert and choose joker
+    positionPiecesOfType(JOKER_LIMIT, JOKER_CHR, vectorToFill);
+    // insert rock
+    positionPiecesOfType(ROCK_LIMIT, ROCK_CHR, vectorToFill);
+    // insert paper
+    positionPiecesOfType(PAPER_LIMIT, PAPER_CHR, vectorToFill);
+    // insert scissors
+    positionPiecesOfType(SCISSORS_LIMIT, SCISSORS_CHR, vectorToFill);
+}
+
 // %% MOVE %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 /**
@@ -496,8 +614,8 @@ bool RSPPlayer_312148190::willWinFight(RSPPlayer_312148190::info& data, int vOri
     if ((destPiece._M_piece == origPiece._M_piece) || (destPiece._M_piece == ROCK_CHR && origPiece._M_piece == SCISSORS_CHR) || (destPiece._M_piece == SCISSORS_CHR && origPiece._M_piece == PAPER_CHR) || (destPiece._M_piece == PAPER_CHR && origPiece._M_piece == ROCK_CHR) || (destPiece._M_piece == BOMB_CHR && origPiece._M_piece != BOMB_CHR) || (destPiece._M_piece != FLAG_CHR && origPiece._M_piece == FLAG_CHR)) {
         return false;
     }
-    // if piece/s unknown, win with a chance of UNKNOWN_WIN_CHANCE
-    if ((destPiece._M_piece == UNKNOWN_CHR || origPiece._M_piece == UNKNOWN_CHR) && chance >= UNKNOWN_WIN_CHANCE) {
+    // if piece/s unknown, win with a chance of the unknown win chance weight
+    if ((destPiece._M_piece == UNKNOWN_CHR || origPiece._M_piece == UNKNOWN_CHR) && chance >= _weights._M_unknown_win_chance) {
         return false;
     }
     return true;
@@ -547,11 +665,11 @@ float RSPPlayer_312148190::calcPlayerBoardScore(RSPPlayer_312148190::info& data)
     const int NUM_OF_PIECES = getNumOfMovingPieces(data, data._M_this_player);
 
     const int K_PROXIMITY = 0.66f * NUM_OF_PIECES;
-    const float PIECES_PARAM = 9.0f;
-    const float ENEMY_FLAG_EXIST_PARAM = -2.5f;
-    const float DANGER_PARAM = -4.0f / NUM_OF_PIECES;
-    const float THREAT_PARAM = 3.0f / NUM_OF_PIECES;
-    const float OPP_FLAG_DIST_PARAM = -9.0f / (float)data._M_other_player._M_flags.size();
+    const float PIECES_PARAM = _weights._M_pieces;
+    const float ENEMY_FLAG_EXIST_PARAM = _weights._M_enemy_flag_exist;
+    const float DANGER_PARAM = _weights._M_danger / NUM_OF_PIECES;
+    const float THREAT_PARAM = _weights._M_threat / NUM_OF_PIECES;
+    const float OPP_FLAG_DIST_PARAM = _weights._M_opp_flag_dist / (float)data._M_other_player._M_flags.size();
 
     float score = 0.0f; // lower is worse heigher is better
     float avg = 0.0f;
@@ -648,67 +766,212 @@ float RSPPlayer_312148190::getScoreForMove(RSPPlayer_312148190::info& data, RSPP
 }
 
 /**
- * @brief Gets a "score" for a potential joker-change on the board,
- *  as in "how good this joker-change will be for the player"
+ * @brief Calculates the danger and threat terms of calcPlayerBoardScore for a single piece of this player.
  * 
- * @param data - a copy of the struct info, used to perform a hypothetical move on it 
+ * @param data - a reference to the struct info
+ * @param vPos - the position of the piece
+ * @param vNumOfPieces - the number of moving pieces of this player (the terms are divided by it)
+ * @return float - the danger and threat score of the piece
+ */
+float RSPPlayer_312148190::calcPieceLocalScore(RSPPlayer_312148190::info& data, int vPos, int vNumOfPieces)
+{
+    float score = 0.0f;
+
+    if (vNumOfPieces <= 0 || data._M_board[vPos]._M_piece == BOMB_CHR || data._M_board[vPos]._M_piece == FLAG_CHR) {
+        return score;
+    }
+    if (isPieceInDanger(data, vPos))
+        score += _weights._M_danger / vNumOfPieces;
+    if (isPieceThreatening(data, vPos))
+        score += _weights._M_threat / vNumOfPieces;
+    return score;
+}
+
+/**
+ * @brief Gets the change in the "score" of the board for a potential joker-change,
+ *  as in "how good this joker-change will be for the player".
+ *  Instead of copying and rescoring the whole board, only the terms the joker affects are recomputed:
+ *  the danger and threat of the joker itself, and the change in the number of moving pieces.
+ * 
+ * @param data - a reference to the struct info, the joker is changed temporarily and restored
  * @param vChange - the potential joker-change
- * @return float - the calculated score
+ * @return float - the calculated score change (0 for no change)
  */
-float RSPPlayer_312148190::getScoreForJokerChange(RSPPlayer_312148190::info data, RSPPlayer_312148190::joker_change vChange)
+float RSPPlayer_312148190::getScoreDeltaForJokerChange(RSPPlayer_312148190::info& data, RSPPlayer_312148190::joker_change vChange)
 {
+    RSPPlayer_312148190::piece& joker = data._M_board[vChange._M_position];
+    const char prevRep = joker._M_piece;
+    int numOfPieces, newNumOfPieces;
+    float delta = 0.0f;
+
     // just in case
-    if (data._M_board[vChange._M_position]._M_player == NO_PLAYER || !data._M_board[vChange._M_position]._M_isJoker) {
-        return 0.0f;
+    if (joker._M_player == NO_PLAYER || !joker._M_isJoker || prevRep == vChange._M_new_rep) {
+        return delta;
     }
 
-    data._M_board[vChange._M_position]._M_piece = vChange._M_new_rep;
-    return calcPlayerBoardScore(data);
+    numOfPieces = getNumOfMovingPieces(data, data._M_this_player);
+    newNumOfPieces = numOfPieces + (prevRep == BOMB_CHR ? 1 : 0) - (vChange._M_new_rep == BOMB_CHR ? 1 : 0);
+
+    delta -= calcPieceLocalScore(data, vChange._M_position, numOfPieces);
+    joker._M_piece = vChange._M_new_rep;
+    delta += calcPieceLocalScore(data, vChange._M_position, newNumOfPieces);
+    joker._M_piece = prevRep;
+
+    delta += _weights._M_pieces * (newNumOfPieces - numOfPieces);
+    return delta;
 }
 
 /**
- * @brief Gets the best move possible out of all available moves for this player
+ * @brief Gets the index of a move in the history table, by its origin and direction.
+ * 
+ * @param vMove - the move
+ * @return int - the index in the history table
+ */
+/*static*/ int RSPPlayer_312148190::getHistoryIndex(const RSPPlayer_312148190::move& vMove)
+{
+    int direction;
+    switch (vMove._M_to - vMove._M_from) {
+    case -DIM_X:
+        direction = 0;
+        break;
+    case DIM_X:
+        direction = 1;
+        break;
+    case -1:
+        direction = 2;
+        break;
+    default:
+        direction = 3;
+        break;
+    }
+    return vMove._M_from * NUM_OF_DIRECTIONS + direction;
+}
+
+/**
+ * @brief Gets the ordering key of a possible move. Captures of suspected flags come first, then fights (the possible moves only contain fights the piece is expected to win), then killer moves, and the rest by the history heuristic.
+ * 
+ * @param data - a reference of the struct info
+ * @param vMove - a possible move
+ * @return int - the ordering key, higher is tried first
+ */
+int RSPPlayer_312148190::getMoveOrderKey(RSPPlayer_312148190::info& data, const RSPPlayer_312148190::move& vMove) const
+{
+    int key = this->_history[getHistoryIndex(vMove)];
+
+    if (data._M_other_player._M_flags.count(vMove._M_to) > 0) {
+        key += FLAG_CAPTURE_ORDER;
+    } else if (data._M_board[vMove._M_to]._M_player == data._M_other_player._M_id) {
+        key += FIGHT_ORDER;
+    }
+    for (auto& killer : this->_killers) {
+        if (killer._M_from == vMove._M_from && killer._M_to == vMove._M_to) {
+            key += KILLER_ORDER;
+            break;
+        }
+    }
+    return key;
+}
+
+/**
+ * @brief Gets all the possible moves for this player, ordered so the most promising moves are first.
+ * 
+ * @param data - a reference of the struct info
+ * @param rMoves - a vector to be filled with the ordered moves
+ */
+void RSPPlayer_312148190::getOrderedMoves(RSPPlayer_312148190::info& data, std::vector<RSPPlayer_312148190::move>& rMoves)
+{
+    std::vector<std::pair<int, RSPPlayer_312148190::move>> keyedMoves;
+    std::vector<int> possibleMoves;
+
+    for (auto pos : data._M_this_player._M_pieces) {
+        getPossibleMovesForPiece(data, pos, possibleMoves);
+        for (auto mov : possibleMoves) {
+            RSPPlayer_312148190::move currMove = { pos, mov };
+            keyedMoves.emplace_back(getMoveOrderKey(data, currMove), currMove);
+        }
+        possibleMoves.clear();
+    }
+    // stable, so equal keys keep the board order
+    std::stable_sort(keyedMoves.begin(), keyedMoves.end(), [](const std::pair<int, RSPPlayer_312148190::move>& a, const std::pair<int, RSPPlayer_312148190::move>& b) { return a.first > b.first; });
+    for (auto& keyed : keyedMoves) {
+        rMoves.push_back(keyed.second);
+    }
+}
+
+/**
+ * @brief Updates the killer moves and the history heuristic with the move chosen this turn.
+ * 
+ * @param vMove - the chosen move
+ */
+void RSPPlayer_312148190::updateMoveHeuristics(const RSPPlayer_312148190::move& vMove)
+{
+    int idx = getHistoryIndex(vMove);
+
+    if (this->_killers[0]._M_from != vMove._M_from || this->_killers[0]._M_to != vMove._M_to) {
+        for (int i = NUM_OF_KILLER_MOVES - 1; i > 0; --i) {
+            this->_killers[i] = this->_killers[i - 1];
+        }
+        this->_killers[0] = vMove;
+    }
+    if (++this->_history[idx] >= HISTORY_LIMIT) {
+        for (auto& count : this->_history) {
+            count /= 2;
+        }
+    }
+}
+
+/**
+ * @brief Gets the best move possible out of all available moves for this player. The moves are searched in order (see getOrderedMoves), and the search stops when the last suspected flag can be captured.
  * 
  * @param data - a reference of the struct info
  * @return RSPPlayer_312148190::move - the move that has the highest score among all other valid moves
  */
 RSPPlayer_312148190::move RSPPlayer_312148190::getBestMoveForPlayer(RSPPlayer_312148190::info& data)
 {
-    RSPPlayer_312148190::move currMove, maxMove;
+    RSPPlayer_312148190::move maxMove;
     RSPPlayer_312148190::move anyMove;
-    std::vector<int> possibleMoves;
-    double countPossibleMoves = 0;
+    RSPPlayer_312148190::move repeatedMove;
+    std::vector<RSPPlayer_312148190::move> orderedMoves;
     float currScore = 0;
     float anyScore = std::numeric_limits<float>::min();
 
     // get the current score of the board
     float maxScore = calcPlayerBoardScore(data);
 
+    // our previous move, the latest move in the history is the opponent's (pushed by notifyOnOpponentMove)
+    const RSPPlayer_312148190::move* pPrevMove = data._M_moves._M_size > 1 ? &data._M_moves.get(1) : nullptr;
+
     // get the best move possible out of all available moves
-    for (auto pos = data._M_this_player._M_pieces.begin(); pos != data._M_this_player._M_pieces.end(); ++pos) {
-        getPossibleMovesForPiece(data, *pos, possibleMoves);
-        countPossibleMoves += possibleMoves.size();
-        for (auto mov = possibleMoves.begin(); mov != possibleMoves.end(); ++mov) {
-            currMove = { *pos, *mov };
-            // make sure doesn't go back and forth
-            if (data._M_moves.size() > 0 && data.peekMove()._M_from == *mov && data.peekMove()._M_to == *pos)
-                continue;
-            // will use a copy of the data
-            currScore = getScoreForMove(data, currMove);
-            if ((maxMove._M_from == -1 && maxMove._M_to == -1 && currScore >= maxScore) || (currScore > maxScore)) {
-                maxMove = currMove;
-                maxScore = currScore;
-            } else if (currScore > anyScore) {
-                anyMove = currMove;
-                anyScore = currScore;
-            }
+    getOrderedMoves(data, orderedMoves);
+    for (auto& currMove : orderedMoves) {
+        // capturing the last suspected flag wins the game, no need to look further (even if it repeats a move)
+        if (data._M_other_player._M_flags.size() == 1 && data._M_other_player._M_flags.count(currMove._M_to) > 0) {
+            maxMove = currMove;
+            break;
+        }
+        // make sure doesn't go back and forth (or repeat the same move over and over)
+        if ((pPrevMove != nullptr && pPrevMove->_M_from == currMove._M_to && pPrevMove->_M_to == currMove._M_from) || data._M_moves.countRepetitions(currMove) >= MOVE_REPETITION_LIMIT) {
+            if (repeatedMove._M_from == -1 && repeatedMove._M_to == -1)
+                repeatedMove = currMove;
+            continue;
+        }
+        // will use a copy of the data
+        currScore = getScoreForMove(data, currMove);
+        if ((maxMove._M_from == -1 && maxMove._M_to == -1 && currScore >= maxScore) || (currScore > maxScore)) {
+            maxMove = currMove;
+            maxScore = currScore;
+        } else if (currScore > anyScore) {
+            anyMove = currMove;
+            anyScore = currScore;
         }
-        possibleMoves.clear();
     }
 
-    // if couldn't find a good move, just return any move
+    // if couldn't find a good move, just return any move, or a repeated move if it's the only option
     // if no move was possible returns an illegal move
     if (maxMove._M_from == -1 && maxMove._M_to == -1) {
+        if (anyMove._M_from == -1 && anyMove._M_to == -1) {
+            return repeatedMove;
+        }
         return anyMove;
     }
     return maxMove;
@@ -724,14 +987,15 @@ RSPPlayer_312148190::joker_change RSPPlayer_312148190::getBestJokerChangeForPlay
 {
     RSPPlayer_312148190::joker_change currChange, bestChange;
     float currScore = 0;
-    float maxScore = calcPlayerBoardScore(data);
+    // scores are relative to the current board
+    float maxScore = 0;
     std::array<char, 4> possibleChanges = { ROCK_CHR, PAPER_CHR, SCISSORS_CHR, BOMB_CHR };
 
     // for all the current jokers, go over all the possible joker rep changes
     for (auto pos : data._M_this_player._M_jokers) {
         for (auto change : possibleChanges) {
             currChange = { pos, change };
-            currScore = getScoreForJokerChange(data, currChange);
+            currScore = getScoreDeltaForJokerChange(data, currChange);
             if (currScore >= maxScore) {
                 bestChange = currChange;
                 maxScore = currScore;
@@ -745,8 +1009,7 @@ RSPPlayer_312148190::joker_change RSPPlayer_312148190::getBestJokerChangeForPlay
 
 /**
  * @brief Fills vectorToFill with the initial board positions of this player.
- * Implemented with Smart Random method, which spreads the pices randomly.
- * It will not place two pieces in the same spot.
+ * If an opening book exists, a setup is sampled from it. Otherwise the pieces are positioned randomly.
  * 
  * @param player - int representation of current player  
  * @param vectorToFill - the vector sepcified above to be filled
@@ -754,23 +1017,12 @@ RSPPlayer_312148190::joker_change RSPPlayer_312148190::getBestJokerChangeForPlay
 void RSPPlayer_312148190::getInitialPositions(int player,
     std::vector<unique_ptr<PiecePosition>>& vectorToFill)
 {
-    // set the player number
-    this->_info._M_this_player._M_id = player;
-
-    // position the flag and bombs (1 and 2 respectively)
-    positionInitial(vectorToFill);
-    // insert remaining flags if exist
-    positionPiecesOfType(FLAG_LIMIT - 1, FLAG_CHR, vectorToFill);
-    // insert remaining bombs if exist
-    positionPiecesOfType(BOMB_LIMIT - 2, BOMB_CHR, vectorToFill);
-    // insert and choose joker
-    positionPiecesOfType(JOKER_LIMIT, JOKER_CHR, vectorToFill);
-    // insert rock
-    positionPiecesOfType(ROCK_LIMIT, ROCK_CHR, vectorToFill);
-    // insert paper
-    positionPiecesOfType(PAPER_LIMIT, PAPER_CHR, vectorToFill);
-    // insert scissors
-    positionPiecesOfType(SCISSORS_LIMIT, SCISSORS_CHR, vectorToFill);
+    // use a precomputed setup if possible
+    if (getOpeningBook().isLoaded()) {
+        positionFromSetup(player, getOpeningBook().sample(_engine), vectorToFill);
+        return;
+    }
+    positionRandomly(player, vectorToFill);
 }
 
 /**
@@ -820,7 +1072,7 @@ void RSPPlayer_312148190::notifyOnOpponentMove(const Move& move)
 {
     // save the move into history vector
     this->_info.addMove(getPos(move.getFrom().getX() - 1, move.getFrom().getY() - 1), getPos(move.getTo().getX() - 1, move.getTo().getY() - 1));
-    // now _M_moves is sure to have at least one move (i.e. size() > 0)
+    // now _M_moves is sure to have at least one move (i.e. not empty)
 
     this->_info.updateJoker(this->_info.peekMove()._M_from);
     this->_info.removeFlag(this->_info.peekMove()._M_to);
@@ -841,7 +1093,7 @@ void RSPPlayer_312148190::notifyFightResult(const FightInfo& fightInfo)
 {
     int fightPos = getPos(fightInfo.getPosition().getX() - 1, fightInfo.getPosition().getY() - 1);
 
-    // since there was a fight, _M_moves is sure to have at least one move (i.e. size() > 0)
+    // since there was a fight, _M_moves is sure to have at least one move (i.e. not empty)
 
     if (fightPos != this->_info.peekMove()._M_to) {
         // safety check
@@ -887,7 +1139,8 @@ unique_ptr<Move> RSPPlayer_312148190::getMove()
 
     // add to history
     this->_info.addMove(bestMove._M_from, bestMove._M_to);
-    // now _M_moves is sure to have at least one move (i.e. size() > 0)
+    this->updateMoveHeuristics(bestMove);
+    // now _M_moves is sure to have at least one move (i.e. not empty)
 
     // perform the move if it's a clean move
     if (this->_info._M_board[bestMove._M_to]._M_player == NO_PLAYER) {
@@ -928,6 +1181,82 @@ unique_ptr<JokerChange> RSPPlayer_312148190::getJokerChange()
     return std::move(retJokerChange);
 }
 
+// %% WEIGHTS %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+/**
+ * @brief Gets the evaluation weights every new player starts with. The weights file is read once per process, if it doesn't exist the hand-picked weights are used.
+ * 
+ * @return const RSPPlayer_312148190::eval_weights& - the shared weights
+ */
+/*static*/ const RSPPlayer_312148190::eval_weights& RSPPlayer_312148190::getDefaultWeights()
+{
+    static const eval_weights weights = [] {
+        eval_weights w;
+        loadWeights(WEIGHTS_PATH, w);
+        return w;
+    }();
+    return weights;
+}
+
+/**
+ * @brief Loads evaluation weights from a text file of "<NAME> <value>" lines. Unknown names are ignored and missing names are left untouched.
+ * 
+ * @param path - the path of the weights file
+ * @param rWeights - the weights to update
+ * @return true - iff the file was opened and read
+ * @return false - otherwise
+ */
+/*static*/ bool RSPPlayer_312148190::loadWeights(const char* path, RSPPlayer_312148190::eval_weights& rWeights)
+{
+    std::ifstream in(path);
+    std::string name;
+    double value;
+
+    if (!in.is_open()) {
+        return false;
+    }
+    while (in >> name >> value) {
+        if (name.compare("PIECES_PARAM") == 0)
+            rWeights._M_pieces = (float)value;
+        else if (name.compare("DANGER_PARAM") == 0)
+            rWeights._M_danger = (float)value;
+        else if (name.compare("THREAT_PARAM") == 0)
+            rWeights._M_threat = (float)value;
+        else if (name.compare("OPP_FLAG_DIST_PARAM") == 0)
+            rWeights._M_opp_flag_dist = (float)value;
+        else if (name.compare("ENEMY_FLAG_EXIST_PARAM") == 0)
+            rWeights._M_enemy_flag_exist = (float)value;
+        else if (name.compare("UNKNOWN_WIN_CHANCE") == 0)
+            rWeights._M_unknown_win_chance = value;
+    }
+    return true;
+}
+
+/**
+ * @brief Saves evaluation weights into a text file, in the format read by loadWeights.
+ * 
+ * @param path - the path of the weights file to (over)write
+ * @param weights - the weights to save
+ * @return true - iff the file was written
+ * @return false - otherwise
+ */
+/*static*/ bool RSPPlayer_312148190::saveWeights(const char* path, const RSPPlayer_312148190::eval_weights& weights)
+{
+    std::ofstream out(path, std::ios::trunc);
+
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "PIECES_PARAM " << weights._M_pieces << std::endl
+        << "DANGER_PARAM " << weights._M_danger << std::endl
+        << "THREAT_PARAM " << weights._M_threat << std::endl
+        << "OPP_FLAG_DIST_PARAM " << weights._M_opp_flag_dist << std::endl
+        << "ENEMY_FLAG_EXIST_PARAM " << weights._M_enemy_flag_exist << std::endl
+        << "UNKNOWN_WIN_CHANCE " << weights._M_unknown_win_chance << std::endl;
+    out.close();
+    return !out.fail();
+}
+
 // %% DEBUG ORIENTED %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 
 /**
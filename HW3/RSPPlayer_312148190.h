@@ -9,12 +9,34 @@
 #define __H_RSP_PLAYER_312148190
 
 #include "GameUtilitiesRPS.h"
+#include "OpeningBook.h"
 #include "PlayerAlgorithm.h"
+#include <array>
 #include <memory>
+#include <random>
 #include <set>
 #include <vector>
 
+// move ordering related
+#define NUM_OF_KILLER_MOVES 2 // the number of killer moves kept between turns
+#define NUM_OF_DIRECTIONS 4 // up, down, left and right
+
+// move history related
+#define MOVE_HISTORY_SIZE 8 // the number of latest moves kept (both players)
+#define MOVE_REPETITION_LIMIT 2 // a move played this many times in the history is not repeated
+
 class RSPPlayer_312148190 : public PlayerAlgorithm {
+public:
+    // the weights of the board evaluation (the danger, threat and flag distance weights are divided by the relevant amount of pieces)
+    struct eval_weights {
+        float _M_pieces = 9.0f; // per moving piece more than the opponent
+        float _M_danger = -4.0f; // per piece in danger
+        float _M_threat = 3.0f; // per threatening piece
+        float _M_opp_flag_dist = -9.0f; // per distance of the pieces from the (thought to be) opponent flags
+        float _M_enemy_flag_exist = -2.5f; // per (thought to be) opponent flag
+        double _M_unknown_win_chance = 0.66; // how aggressive we want the player to be (1 - very aggressive, 0 - not aggressive at all)
+    };
+
 protected:
     // data structures
     // NOTE: The player can't use the classes defined for the game itself since the usage is different, or maybe non existant for him at all. So private simplified structs were implemented to give the player some data structures for representing the thoguht information on the game state. 
@@ -31,6 +53,21 @@ protected:
         int _M_position = -1;
         char _M_new_rep = '\0';
     };
+    // a fixed size history of the latest moves (a ring buffer, older moves are overwritten)
+    struct move_history {
+        std::array<move, MOVE_HISTORY_SIZE> _M_moves;
+        int _M_next = 0; // the index the next move is written into
+        int _M_size = 0; // the number of moves in the history
+
+        // adds a move, overwriting the oldest one if full
+        void push(const move& vMove);
+        // true iff no move was added yet
+        bool empty() const { return _M_size == 0; }
+        // gets the move played vPly moves ago (0 is the latest), assumes vPly < _M_size
+        const move& get(int vPly) const;
+        // counts how many times a move was played in the history
+        int countRepetitions(const move& vMove) const;
+    };
     struct player_info {
         int _M_id;
         std::set<int> _M_pieces; // all pieces except flags (R,P,S,B)
@@ -39,7 +76,7 @@ protected:
     };
     struct info {
         std::array<piece, DIM_X * DIM_Y> _M_board;
-        std::vector<move> _M_moves;
+        move_history _M_moves;
         player_info _M_this_player;
         player_info _M_other_player;
 
@@ -61,14 +98,33 @@ protected:
         const move& peekMove() const;
     };
 
-private:
-    const double UNKNOWN_WIN_CHANCE = 0.66; // how aggressive we want the player to be (1 - very aggressive, 0 - not aggressive at all)
+    // position the pieces of a player by a given setup (used for opening book positioning)
+    void positionFromSetup(int player, const OpeningSetup& setup, std::vector<unique_ptr<PiecePosition>>& vectorToFill);
+    // position the pieces of a player randomly (flag and bombs in a corner)
+    void positionRandomly(int player, std::vector<unique_ptr<PiecePosition>>& vectorToFill);
+    // gets the opening book shared by all the player instances (mapped once, on first use)
+    static const OpeningBook& getOpeningBook();
 
+private:
+    eval_weights _weights; // the weights used to evaluate a board
     info _info; // will hold the current info on the thought state of the game
+    std::array<move, NUM_OF_KILLER_MOVES> _killers; // the latest best moves, most recent first (kept across turns)
+    std::array<int, DIM_X * DIM_Y * NUM_OF_DIRECTIONS> _history = {}; // how many times each (origin, direction) move was chosen
+    std::mt19937 _engine; // per player random engine (players may run on different threads)
 
 public:
-    // basic c'tor
-    RSPPlayer_312148190() {}
+    // basic c'tor (uses the tuned weights if a weights file exists)
+    RSPPlayer_312148190()
+        : _weights(getDefaultWeights())
+        , _engine(std::random_device{}())
+    {
+    }
+    // c'tor with explicit evaluation weights
+    explicit RSPPlayer_312148190(const eval_weights& weights)
+        : _weights(weights)
+        , _engine(std::random_device{}())
+    {
+    }
     // no need for copy c'tor
     RSPPlayer_312148190(const RSPPlayer_312148190& other) = delete;
 
@@ -121,9 +177,19 @@ private:
     float getScoreForMove(info& data, move& vMove);
     // calculate the best move for a player to perform
     move getBestMoveForPlayer(info& data);
+    // get all the possible moves for a player, most promising first
+    void getOrderedMoves(info& data, std::vector<move>& rMoves);
+    // get the ordering key of a possible move (higher is tried first)
+    int getMoveOrderKey(info& data, const move& vMove) const;
+    // update the killer moves and history with the chosen move
+    void updateMoveHeuristics(const move& vMove);
+    // get the index of a move in the history table
+    static int getHistoryIndex(const move& vMove);
 
-    // calculate the "score" for a board representation
-    float getScoreForJokerChange(info data, joker_change vChange);
+    // get the danger and threat score of a single piece
+    float calcPieceLocalScore(info& data, int vPos, int vNumOfPieces);
+    // gets the change in the board score caused by a joker change (computed locally around the joker)
+    float getScoreDeltaForJokerChange(info& data, joker_change vChange);
     // get the best joker change if one exists
     joker_change getBestJokerChangeForPlayer(info& data);
 
@@ -143,6 +209,13 @@ private:
     static bool isPosValid(int x, int y, int n_x, int n_y);
 
 public:
+    // gets the weights loaded from the weights file (mapped once, on first use), or the default weights
+    static const eval_weights& getDefaultWeights();
+    // loads evaluation weights from a text file, missing entries are left untouched
+    static bool loadWeights(const char* path, eval_weights& rWeights);
+    // saves evaluation weights into a text file
+    static bool saveWeights(const char* path, const eval_weights& weights);
+
     // prints the full state of the object nicely
     void prettyPrint();
     // prints the state of the "board" nicely
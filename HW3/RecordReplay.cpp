@@ -0,0 +1,132 @@
+/**
+ * @brief The offline tool replaying recorded tournament games. Re-verifies the winner of every game and
+ * collects fight statistics by piece type, without running the player algorithms.
+ *
+ * @file RecordReplay.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-08
+ */
+#include "GameRecordReader.h"
+#include "ReplayEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define MSG_INVALID_FORMAT "Please call using the following format: <exe> [-threads <number>] <record file> [<record file> ...]"
+#define ERR_RETURN -1
+#define INF "[INFO] "
+#define ERR "[ERROR] "
+
+// the maximal number of mismatching games printed
+#define MAX_PRINTED_MISMATCHES 10
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> paths;
+    std::vector<std::thread> threads;
+    std::atomic<int> nextFile(0);
+    std::atomic<long> numOfBytes(0);
+    std::atomic<int> numOfBadFiles(0);
+    std::mutex resultLock;
+    replay_stats totals;
+    int numOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    int numOfPrinted = 0;
+
+    // collect command line settings
+    for (int i = 1; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg.compare("-threads") != 0) {
+            paths.push_back(arg);
+            continue;
+        }
+        if (argc < i + 2) {
+            std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+            return ERR_RETURN;
+        }
+        try {
+            numOfThreads = std::stoi(argv[++i]);
+        } catch (...) {
+            numOfThreads = 0;
+        }
+        if (numOfThreads <= 0) {
+            std::cout << ERR << "Please specify a positive number for '-threads', '" << argv[i] << "' is not a valid value." << std::endl;
+            return ERR_RETURN;
+        }
+    }
+    if (paths.empty()) {
+        std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+        return ERR_RETURN;
+    }
+    numOfThreads = std::min(numOfThreads, (int)paths.size());
+
+    // every thread takes whole files, with its own reader and engine
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            GameRecordReader reader;
+            GameRecord record;
+            ReplayEngine engine;
+            int i, winner;
+
+            while ((i = nextFile++) < (int)paths.size()) {
+                if (!reader.open(paths[i].c_str())) {
+                    ++numOfBadFiles;
+                    std::lock_guard<std::mutex> lock(resultLock);
+                    std::cout << ERR << "'" << paths[i] << "' is not a valid record file." << std::endl;
+                    continue;
+                }
+                numOfBytes += (long)reader.getFileSize();
+                // the games are replayed by the draw rules of the tournament that recorded them
+                engine.setDrawRules(reader.getDrawRules());
+                for (int game = 0; game < reader.size(); ++game) {
+                    winner = GAME_IS_STILL_ON;
+                    if (!reader.read(game, record)) {
+                        engine.addUnreadable();
+                        std::lock_guard<std::mutex> lock(resultLock);
+                        if (numOfPrinted++ < MAX_PRINTED_MISMATCHES) {
+                            std::cout << "[MALFORMED] " << paths[i] << " game " << game << ": the game couldn't be decoded." << std::endl;
+                        }
+                        continue;
+                    }
+                    if (engine.replay(record, winner)) {
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> lock(resultLock);
+                    if (numOfPrinted++ < MAX_PRINTED_MISMATCHES) {
+                        std::cout << "[MISMATCH] " << paths[i] << " game " << game << " (" << record.getPlayerId(PLAYER_1) << " vs "
+                                  << record.getPlayerId(PLAYER_2) << "): recorded winner " << record.getWinner() << ", replayed " << winner << std::endl;
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(resultLock);
+            totals.merge(engine.getStats());
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    seconds = std::max(seconds, 1e-9);
+
+    // summary
+    std::cout << INF << "Replayed " << totals._M_games << " games (" << totals._M_turns << " turns) from " << paths.size() - numOfBadFiles
+              << " files in " << std::fixed << std::setprecision(1) << seconds * 1000 << "ms, using " << numOfThreads << " threads." << std::endl;
+    std::cout << INF << "Throughput: " << std::setprecision(0) << totals._M_games / seconds << " games/s, " << totals._M_turns / seconds << " turns/s, "
+              << std::setprecision(1) << numOfBytes / seconds / (1024 * 1024) << " MB/s." << std::endl;
+    std::cout << INF << totals._M_games - totals._M_mismatches << "/" << totals._M_games << " winners verified (" << totals._M_mismatches << " mismatches, "
+              << totals._M_malformed << " malformed)." << std::endl;
+    std::cout << INF << "Fights by piece type:" << std::endl;
+    std::cout << "piece\tfights\twins\tlosses\tties" << std::endl;
+    for (int i = 0; i < NUM_OF_FIGHT_TYPES; ++i) {
+        const fight_stats& stats = totals._M_pieces[i];
+        std::cout << ReplayEngine::getFightType(i) << "\t" << stats._M_fights << "\t" << stats._M_wins << "\t" << stats._M_losses << "\t" << stats._M_ties << std::endl;
+    }
+    return totals._M_mismatches == 0 && numOfBadFiles == 0 ? 0 : 1;
+}
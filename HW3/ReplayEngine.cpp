@@ -0,0 +1,249 @@
+/**
+ * @brief The implementation file of the ReplayEngine class.
+ *
+ * @file ReplayEngine.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-08
+ */
+#include "ReplayEngine.h"
+#include "JokerChangeRPS.h"
+#include "MoveRPS.h"
+#include "PieceRPS.h"
+#include "PointRPS.h"
+
+#include <memory>
+
+// the piece types in the order of the fight statistics
+static const char fightTypes[NUM_OF_FIGHT_TYPES] = { ROCK_CHR, PAPER_CHR, SCISSORS_CHR, BOMB_CHR, FLAG_CHR };
+
+/**
+ * @brief Adds the totals of other to this.
+ *
+ * @param other - the totals to add
+ */
+void replay_stats::merge(const replay_stats& other)
+{
+    _M_games += other._M_games;
+    _M_turns += other._M_turns;
+    _M_mismatches += other._M_mismatches;
+    _M_malformed += other._M_malformed;
+    for (int i = 0; i < NUM_OF_FIGHT_TYPES; ++i) {
+        _M_pieces[i]._M_fights += other._M_pieces[i]._M_fights;
+        _M_pieces[i]._M_wins += other._M_pieces[i]._M_wins;
+        _M_pieces[i]._M_losses += other._M_pieces[i]._M_losses;
+        _M_pieces[i]._M_ties += other._M_pieces[i]._M_ties;
+    }
+}
+
+ReplayEngine::ReplayEngine()
+    : _board(DIM_X, DIM_Y)
+{
+}
+
+/**
+ * @brief Gets the index of a piece type in the fight statistics.
+ *
+ * @param piece - the piece type
+ * @return int - the index, or -1 if the type doesn't take part in fights
+ */
+/*static*/ int ReplayEngine::getFightTypeIndex(char piece)
+{
+    for (int i = 0; i < NUM_OF_FIGHT_TYPES; ++i) {
+        if (fightTypes[i] == piece) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Gets the piece type of an index in the fight statistics.
+ *
+ * @param index - the index
+ * @return char - the piece type
+ */
+/*static*/ char ReplayEngine::getFightType(int index)
+{
+    return fightTypes[index];
+}
+
+/**
+ * @brief Adds a fight to the statistics of both piece types.
+ *
+ * @param fightInfo - the fight
+ */
+void ReplayEngine::countFight(const FightInfo& fightInfo)
+{
+    int index;
+
+    for (int player = PLAYER_1; player <= NUM_OF_PLAYERS; ++player) {
+        index = getFightTypeIndex(fightInfo.getPiece(player));
+        if (index < 0) {
+            continue;
+        }
+        fight_stats& rStats = _stats._M_pieces[index];
+        ++rStats._M_fights;
+        if (fightInfo.getWinner() == NO_PLAYER) {
+            ++rStats._M_ties;
+        } else if (fightInfo.getWinner() == player) {
+            ++rStats._M_wins;
+        } else {
+            ++rStats._M_losses;
+        }
+    }
+}
+
+/**
+ * @brief Places the recorded pieces of a player, the same as GameManager::fillBoard.
+ *
+ * @param player - the player
+ * @param rScoreManager - the score manager of the game
+ * @return true - if all the placements are legal
+ * @return false - if a placement is bad (the player is dismissed)
+ */
+bool ReplayEngine::fillBoard(int player, ScoreManager& rScoreManager)
+{
+    std::unique_ptr<PiecePosition> piece;
+    std::unique_ptr<FightInfo> fightInfo;
+    bool isJoker;
+    char type;
+
+    for (auto& placement : _placements[player - 1]) {
+        isJoker = placement._M_piece == JOKER_CHR;
+        type = isJoker ? placement._M_joker_rep : placement._M_piece;
+        piece = std::make_unique<PieceRPS>(player, isJoker, type, PointRPS(placement._M_x, placement._M_y));
+        if (!_board.placePiece(player, piece, fightInfo)) {
+            rScoreManager.dismissPlayer(player);
+            return false;
+        }
+        rScoreManager.increaseNumOfPieces(player, type);
+        if (fightInfo != nullptr) {
+            rScoreManager.notifyFight(*fightInfo);
+            countFight(*fightInfo);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Plays a recorded turn, the same as GameManager::playCurrTurn, and checks it against the record.
+ *
+ * @param turn - the recorded turn
+ * @param rScoreManager - the score manager of the game
+ * @return true - if the fight result and the dismissal of the turn match the record
+ * @return false - otherwise
+ */
+bool ReplayEngine::playTurn(const record_turn& turn, ScoreManager& rScoreManager)
+{
+    std::unique_ptr<FightInfo> fightInfo;
+    std::unique_ptr<JokerChange> jokerChange;
+    std::unique_ptr<Move> move;
+    bool dismissed = false;
+    char jokerPrevChar;
+    int fightWinner = GAME_IS_STILL_ON;
+
+    if (!turn._M_has_move) {
+        if (turn._M_dismissed) {
+            // the player lost on time, the game manager dropped its move
+            rScoreManager.dismissPlayer(turn._M_player);
+        }
+        return !turn._M_has_joker_change;
+    }
+    move = std::make_unique<MoveRPS>(PointRPS(turn._M_from_x, turn._M_from_y), PointRPS(turn._M_to_x, turn._M_to_y));
+    if (!_board.movePiece(turn._M_player, move, fightInfo)) {
+        rScoreManager.dismissPlayer(turn._M_player);
+        return turn._M_dismissed && !turn._M_has_joker_change;
+    }
+    if (fightInfo != nullptr) {
+        rScoreManager.notifyFight(*fightInfo);
+        countFight(*fightInfo);
+        fightWinner = fightInfo->getWinner();
+    }
+    if (turn._M_has_joker_change) {
+        PointRPS position(turn._M_joker_x, turn._M_joker_y);
+        jokerChange = std::make_unique<JokerChangeRPS>(position, turn._M_joker_rep);
+        // the position is checked first, the game manager assumes the joker change is on the board
+        if (turn._M_joker_x < 1 || turn._M_joker_x > DIM_X || turn._M_joker_y < 1 || turn._M_joker_y > DIM_Y
+            || _board.getPieceAt(position) == nullptr) {
+            dismissed = true;
+        } else {
+            jokerPrevChar = _board.getPieceAt(position)->getJokerRep();
+            if (_board.changeJoker(turn._M_player, jokerChange)) {
+                rScoreManager.notifyJokerChange(*jokerChange, jokerPrevChar, turn._M_player);
+            } else {
+                dismissed = true;
+            }
+        }
+        if (dismissed) {
+            rScoreManager.dismissPlayer(turn._M_player);
+        }
+    }
+    return dismissed == turn._M_dismissed && fightWinner == turn._M_fight_winner;
+}
+
+/**
+ * @brief Counts a game that couldn't be decoded from its file, so a corrupted file fails the verification
+ * the same as a malformed game.
+ *
+ */
+void ReplayEngine::addUnreadable()
+{
+    ++_stats._M_games;
+    ++_stats._M_malformed;
+    ++_stats._M_mismatches;
+}
+
+/**
+ * @brief Replays a recorded game, the same as GameManager::PlayRPS, and checks it against the record.
+ *
+ * @param record - the recorded game
+ * @param rWinner - set to the replayed winner (GAME_IS_STILL_ON if the record is malformed)
+ * @return true - if every turn and the winner match the record
+ * @return false - otherwise
+ */
+bool ReplayEngine::replay(const GameRecord& record, int& rWinner)
+{
+    ScoreManager scoreManager;
+    bool fillRes1, fillRes2, matches = true, drawn = false;
+    int turn = 0;
+
+    rWinner = GAME_IS_STILL_ON;
+    ++_stats._M_games;
+    if (!record.readPlacements(PLAYER_1, _placements[PLAYER_1 - 1]) || !record.readPlacements(PLAYER_2, _placements[PLAYER_2 - 1])
+        || !record.readTurns(_turns)) {
+        ++_stats._M_malformed;
+        ++_stats._M_mismatches;
+        return false;
+    }
+
+    _board.clearBoard();
+    fillRes1 = fillBoard(PLAYER_1, scoreManager);
+    fillRes2 = fillBoard(PLAYER_2, scoreManager);
+
+    if (!fillRes1 || !fillRes2) {
+        rWinner = scoreManager.getWinner();
+        matches = _turns.empty();
+    } else {
+        _drawDetector.reset(_drawRules, _board);
+        while (turn < MAX_NUM_OF_MOVES && !scoreManager.isGameOver() && !drawn && turn < (int)_turns.size()) {
+            matches = playTurn(_turns[turn], scoreManager) && matches;
+            ++turn;
+            if (_drawRules.isEnabled() && !scoreManager.isGameOver()) {
+                drawn = _drawDetector.isDraw(_board, (turn % NUM_OF_PLAYERS) + 1);
+            }
+        }
+        _stats._M_turns += turn;
+        if (scoreManager.isGameOver()) {
+            rWinner = scoreManager.getWinner();
+        } else if (turn >= MAX_NUM_OF_MOVES || drawn) {
+            rWinner = NO_PLAYER;
+        }
+        // the game should end exactly where the record ends
+        matches = matches && turn == (int)_turns.size();
+    }
+    matches = matches && rWinner == record.getWinner();
+    if (!matches) {
+        ++_stats._M_mismatches;
+    }
+    return matches;
+}
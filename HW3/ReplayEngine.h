@@ -0,0 +1,99 @@
+/**
+ * @brief The header file of the ReplayEngine class.
+ *
+ * @file ReplayEngine.h
+ * @author Yotam Sechayk
+ * @date 2018-07-08
+ */
+#ifndef __H_REPLAY_ENGINE
+#define __H_REPLAY_ENGINE
+
+#include "BoardRPS.h"
+#include "DrawDetector.h"
+#include "GameRecord.h"
+#include "GameUtilitiesRPS.h"
+#include "ScoreManager.h"
+
+#include <array>
+#include <vector>
+
+// the piece types that take part in fights (a joker fights as its representation)
+#define NUM_OF_FIGHT_TYPES 5
+
+/**
+ * @brief The fights of a single piece type.
+ *
+ */
+struct fight_stats {
+    long _M_fights = 0;
+    long _M_wins = 0;
+    long _M_losses = 0;
+    long _M_ties = 0;
+};
+
+/**
+ * @brief The totals of replayed games.
+ *
+ */
+struct replay_stats {
+    long _M_games = 0; // the number of replayed games
+    long _M_turns = 0; // the number of replayed turns
+    long _M_mismatches = 0; // the number of games whose replay didn't match the record
+    long _M_malformed = 0; // the number of games that couldn't be decoded
+    std::array<fight_stats, NUM_OF_FIGHT_TYPES> _M_pieces; // the fights of each piece type (by getFightTypeIndex)
+
+    // adds the totals of other
+    void merge(const replay_stats& other);
+};
+
+/**
+ * @brief A headless replay of recorded games. The recorded placements and moves are applied directly to a
+ * BoardRPS and a ScoreManager, following the same rules as GameManager::PlayRPS, without any PlayerAlgorithm.
+ * Every replayed game is checked against its record: the number of turns, the fight result and dismissal of
+ * every turn, and the winner returned by PlayRPS. Games of a tournament with draw rules are replayed with the same rules
+ * (as written in the record file).
+ * An engine isn't thread safe, use an engine per thread.
+ *
+ */
+class ReplayEngine {
+private:
+    BoardRPS _board; // the board, cleared and reused for every game
+    std::vector<record_placement> _placements[NUM_OF_PLAYERS]; // the decoded placements of each player of the current game
+    std::vector<record_turn> _turns; // the decoded turns of the current game
+    replay_stats _stats; // the totals of the games replayed by this engine
+    draw_rules _drawRules; // the rules the games were played by
+    DrawDetector _drawDetector; // follows the positions of the current game
+
+public:
+    // basic c'tor
+    ReplayEngine();
+    // no need for copy c'tor
+    ReplayEngine(const ReplayEngine& other) = delete;
+
+    // no need for copy assignment
+    ReplayEngine& operator=(const ReplayEngine& other) = delete;
+
+    // replays a game, true iff the replay matches the record (the replayed winner is set)
+    bool replay(const GameRecord& record, int& rWinner);
+    // counts a game that couldn't be read from its file, a malformed game that doesn't match
+    void addUnreadable();
+    // sets the draw rules of the following games (disabled by default)
+    void setDrawRules(const draw_rules& rRules) { _drawRules = rRules; }
+    // the totals of the games replayed so far
+    const replay_stats& getStats() const { return _stats; }
+
+    // the index of a piece type in the fight statistics (-1 if it doesn't fight)
+    static int getFightTypeIndex(char piece);
+    // the piece type of an index in the fight statistics
+    static char getFightType(int index);
+
+private:
+    // places the pieces of a player, false if the player had a bad positioning
+    bool fillBoard(int player, ScoreManager& rScoreManager);
+    // plays a recorded turn, false if the turn doesn't match the record
+    bool playTurn(const record_turn& turn, ScoreManager& rScoreManager);
+    // adds a fight to the statistics
+    void countFight(const FightInfo& fightInfo);
+};
+
+#endif // !__H_REPLAY_ENGINE
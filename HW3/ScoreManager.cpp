@@ -8,6 +8,15 @@
 #include "ScoreManager.h"
 
 ScoreManager::ScoreManager()
+{
+    reset();
+}
+
+/**
+ * @brief Resets all the counters, as before any piece was positioned.
+ * 
+ */
+void ScoreManager::reset()
 {
     for (int i = 0; i < NUM_OF_PLAYERS; i++) {
         this->_flagPiecesCounter[i] = 0;
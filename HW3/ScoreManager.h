@@ -27,6 +27,9 @@ public:
     // basic c'tor
     ScoreManager();
 
+    // resets the score for a new game
+    void reset();
+
     // updates member fields according to the fight info
     void notifyFight(const FightInfo& rFightInfo);
     // updates member according to the joker change
@@ -0,0 +1,175 @@
+/**
+ * @brief The offline self-play tool tuning the board evaluation weights of the RSPPlayer_312148190 algorithm.
+ * Uses SPSA: every iteration plays a batch of games between two players with opposite random perturbations
+ * of the current weights, and moves the weights towards the perturbation that scored better.
+ *
+ * @file SelfPlayTuner.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-04
+ */
+#include "GameManagerRPS.h"
+#include "RSPPlayer_312148190.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define MSG_INVALID_FORMAT "Please call using the following format: <exe> [-iterations <number>] [-games <number>] [-threads <number>] [-out <weights path>]"
+#define ERR_RETURN -1
+#define INF "[INFO] "
+#define ERR "[ERROR] "
+
+// the number of tuned weights
+#define NUM_OF_WEIGHTS 6
+
+// SPSA gain sequences: a_k = SPSA_A / (k + 1 + SPSA_STABILITY)^SPSA_ALPHA, c_k = SPSA_C / (k + 1)^SPSA_GAMMA
+#define SPSA_A 0.1
+#define SPSA_C 0.1
+#define SPSA_STABILITY 10
+#define SPSA_ALPHA 0.602
+#define SPSA_GAMMA 0.101
+
+using Weights = RSPPlayer_312148190::eval_weights;
+using Vector = std::array<double, NUM_OF_WEIGHTS>;
+
+/**
+ * @brief Converts the evaluation weights into a vector (same order as the weights file).
+ *
+ */
+static Vector toVector(const Weights& w)
+{
+    return { { w._M_pieces, w._M_danger, w._M_threat, w._M_opp_flag_dist, w._M_enemy_flag_exist, w._M_unknown_win_chance } };
+}
+
+/**
+ * @brief Converts a vector back into evaluation weights, keeping the win chance a probability.
+ *
+ */
+static Weights toWeights(const Vector& v)
+{
+    Weights w;
+    w._M_pieces = (float)v[0];
+    w._M_danger = (float)v[1];
+    w._M_threat = (float)v[2];
+    w._M_opp_flag_dist = (float)v[3];
+    w._M_enemy_flag_exist = (float)v[4];
+    w._M_unknown_win_chance = std::min(1.0, std::max(0.0, v[5]));
+    return w;
+}
+
+/**
+ * @brief Plays a batch of games between the two weight sets in parallel. Each game pair is played on both sides.
+ *
+ * @param plus - the weights of the first player
+ * @param minus - the weights of the second player
+ * @param games - the number of game pairs
+ * @param numOfThreads - the number of threads to play on
+ * @return double - the average score of the first player minus the second, in [-1, 1]
+ */
+static double playBatch(const Weights& plus, const Weights& minus, int games, int numOfThreads)
+{
+    std::atomic<int> nextGame(0);
+    std::atomic<int> result(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numOfThreads; ++t) {
+        threads.emplace_back([&] {
+            int local = 0;
+            int winner;
+            while (nextGame++ < games) {
+                winner = GameManager::get().PlayRPS(std::make_unique<RSPPlayer_312148190>(plus), std::make_unique<RSPPlayer_312148190>(minus));
+                local += winner == PLAYER_1 ? 1 : (winner == PLAYER_2 ? -1 : 0);
+                winner = GameManager::get().PlayRPS(std::make_unique<RSPPlayer_312148190>(minus), std::make_unique<RSPPlayer_312148190>(plus));
+                local += winner == PLAYER_2 ? 1 : (winner == PLAYER_1 ? -1 : 0);
+            }
+            result += local;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return (double)result / (2.0 * games);
+}
+
+int main(int argc, char** argv)
+{
+    std::string outPath("./RSPPlayer_312148190.weights");
+    int numOfIterations = 50;
+    int numOfGames = 20;
+    int numOfThreads = std::max(1, (int)std::thread::hardware_concurrency());
+
+    // set the seed for the randomization
+    srand((unsigned)time(NULL));
+
+    // collect command line settings
+    for (int i = 1; i < argc; i += 2) {
+        std::string flag(argv[i]);
+        if (argc < i + 2) {
+            std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+            return ERR_RETURN;
+        }
+        if (flag.compare("-out") == 0) {
+            outPath = argv[i + 1];
+            continue;
+        }
+        int* pValue = flag.compare("-iterations") == 0 ? &numOfIterations : flag.compare("-games") == 0 ? &numOfGames : flag.compare("-threads") == 0 ? &numOfThreads : nullptr;
+        if (pValue == nullptr) {
+            std::cout << ERR << MSG_INVALID_FORMAT << std::endl;
+            return ERR_RETURN;
+        }
+        try {
+            *pValue = std::stoi(argv[i + 1]);
+        } catch (...) {
+            *pValue = 0;
+        }
+        if (*pValue <= 0) {
+            std::cout << ERR << "Please specify a positive number for '" << flag << "', '" << argv[i + 1] << "' is not a valid value." << std::endl;
+            return ERR_RETURN;
+        }
+    }
+
+    // start from the current weights (the weights file, if exists, otherwise the hand-picked ones)
+    Vector theta = toVector(RSPPlayer_312148190::getDefaultWeights());
+    // perturbations are relative to the magnitude of each weight
+    Vector scale;
+    for (int i = 0; i < NUM_OF_WEIGHTS; ++i) {
+        scale[i] = std::max(std::abs(theta[i]), 0.1);
+    }
+
+    std::cout << INF << "Tuning for " << numOfIterations << " iterations of " << 2 * numOfGames << " games, using " << numOfThreads << " threads." << std::endl;
+
+    for (int k = 0; k < numOfIterations; ++k) {
+        double a_k = SPSA_A / std::pow(k + 1 + SPSA_STABILITY, SPSA_ALPHA);
+        double c_k = SPSA_C / std::pow(k + 1, SPSA_GAMMA);
+        Vector delta, plus, minus;
+
+        for (int i = 0; i < NUM_OF_WEIGHTS; ++i) {
+            delta[i] = std::rand() % 2 == 0 ? -1.0 : 1.0;
+            plus[i] = theta[i] + c_k * scale[i] * delta[i];
+            minus[i] = theta[i] - c_k * scale[i] * delta[i];
+        }
+
+        double y = playBatch(toWeights(plus), toWeights(minus), numOfGames, numOfThreads);
+
+        // gradient ascent step on the estimated gradient (in scaled coordinates)
+        for (int i = 0; i < NUM_OF_WEIGHTS; ++i) {
+            theta[i] += a_k * scale[i] * y / (2.0 * c_k * delta[i]);
+        }
+        theta = toVector(toWeights(theta));
+
+        std::cout << INF << "Iteration " << k + 1 << ": score difference " << y << std::endl;
+        // save every iteration, so a stopped run still leaves usable weights
+        if (!RSPPlayer_312148190::saveWeights(outPath.c_str(), toWeights(theta))) {
+            std::cout << ERR << "Failed to write the weights to '" << outPath << "'." << std::endl;
+            return ERR_RETURN;
+        }
+    }
+
+    std::cout << INF << "Wrote the tuned weights to '" << outPath << "'." << std::endl;
+    return 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @brief The implementation file of the time control of the players.
+ *
+ * @file TimeControl.cpp
+ * @author Yotam Sechayk
+ * @date 2018-07-14
+ */
+#include "TimeControl.h"
+
+#include <algorithm>
+#include <chrono>
+#include <pthread.h>
+
+// initialization of the static members
+std::mutex Watchdog::slotsLock;
+std::vector<std::unique_ptr<watch_slot>> Watchdog::slots;
+std::atomic<bool> Watchdog::running(false);
+std::atomic<int> Watchdog::generation(0);
+long Watchdog::timeoutMicros = 0;
+std::thread Watchdog::thread;
+Watchdog::HangHandler Watchdog::handler;
+
+// the watchdog slot of the thread, registered on its first measured game, valid only in its generation
+static thread_local watch_slot* localSlot = nullptr;
+static thread_local int localGeneration = -1;
+
+/**
+ * @brief Gets the bucket of a latency.
+ *
+ * @param micros - the latency
+ * @return int - the bucket, the last bucket for anything longer than the buckets
+ */
+/*static*/ int latency_histogram::getBucket(long micros)
+{
+    int bucket = 0;
+
+    while (bucket < NUM_OF_LATENCY_BUCKETS - 1 && micros >= getBucketLimit(bucket)) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+/**
+ * @brief Adds a call to the histogram.
+ *
+ * @param micros - the time of the call
+ */
+void latency_histogram::add(long micros)
+{
+    ++_M_buckets[getBucket(micros)];
+    ++_M_calls;
+    _M_totalMicros += micros;
+    _M_maxMicros = std::max(_M_maxMicros, micros);
+}
+
+/**
+ * @brief Adds the calls and the forfeits of another histogram.
+ *
+ * @param other - the histogram to add
+ */
+void latency_histogram::merge(const latency_histogram& other)
+{
+    for (int i = 0; i < NUM_OF_LATENCY_BUCKETS; ++i) {
+        _M_buckets[i] += other._M_buckets[i];
+    }
+    _M_calls += other._M_calls;
+    _M_totalMicros += other._M_totalMicros;
+    _M_maxMicros = std::max(_M_maxMicros, other._M_maxMicros);
+    _M_forfeits += other._M_forfeits;
+}
+
+/**
+ * @brief Gets the percentile of the calls, to the precision of the buckets.
+ *
+ * @param percent - the percentile, 0 to 100
+ * @return long - the upper bound of the bucket of the percentile (the slowest call for the last bucket), 0 if there are no calls
+ */
+long latency_histogram::getPercentile(double percent) const
+{
+    long count = 0;
+
+    for (int i = 0; i < NUM_OF_LATENCY_BUCKETS; ++i) {
+        count += _M_buckets[i];
+        if (count > 0 && count >= _M_calls * percent / 100) {
+            return i == NUM_OF_LATENCY_BUCKETS - 1 ? _M_maxMicros : std::min(getBucketLimit(i), _M_maxMicros);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Starts the watchdog thread.
+ *
+ * @param callTimeoutMicros - the wall clock time after which a call is hung
+ * @param hangHandler - called from the watchdog thread on the first hung call
+ */
+/*static*/ void Watchdog::start(long callTimeoutMicros, HangHandler hangHandler)
+{
+    timeoutMicros = callTimeoutMicros;
+    handler = std::move(hangHandler);
+    ++generation;
+    running = true;
+    thread = std::thread(run);
+}
+
+/**
+ * @brief Stops the watchdog thread. The slots are released, no thread may be playing. The threads' pointers to their
+ * slots are left behind with the generation, a thread registers a new slot if the watchdog is started again.
+ *
+ */
+/*static*/ void Watchdog::stop()
+{
+    if (!running) {
+        return;
+    }
+    running = false;
+    thread.join();
+    std::lock_guard<std::mutex> lock(slotsLock);
+    slots.clear();
+    ++generation;
+    localSlot = nullptr;
+}
+
+/**
+ * @brief Gets the slot of the calling thread, registering it on first use.
+ *
+ * @return watch_slot* - the slot, nullptr if the watchdog isn't running
+ */
+/*static*/ watch_slot* Watchdog::local()
+{
+    if (!running) {
+        return nullptr;
+    }
+    if (localSlot == nullptr || localGeneration != generation) {
+        std::unique_ptr<watch_slot> slot = std::make_unique<watch_slot>();
+        if (pthread_getcpuclockid(pthread_self(), &slot->_M_cpuClock) != 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(slotsLock);
+        localSlot = slot.get();
+        localGeneration = generation;
+        slots.push_back(std::move(slot));
+    }
+    return localSlot;
+}
+
+/**
+ * @brief Gets the wall clock time (monotonic).
+ *
+ * @return long - the time, in microseconds
+ */
+/*static*/ long Watchdog::now()
+{
+    return (long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief The watchdog thread: samples the call in progress of every slot, and calls the handler on the first hung call.
+ * A call is read twice by its start, so the algorithm and the call read belong to the same call.
+ *
+ */
+/*static*/ void Watchdog::run()
+{
+    struct timespec ts;
+    long start, wall, cpu;
+    const char* id;
+    const char* call;
+
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(WATCHDOG_PERIOD_MS));
+        std::lock_guard<std::mutex> lock(slotsLock);
+        for (auto& rpSlot : slots) {
+            if ((start = rpSlot->_M_callStart.load(std::memory_order_acquire)) == 0) {
+                continue;
+            }
+            if ((wall = now() - start) <= timeoutMicros) {
+                continue;
+            }
+            id = rpSlot->_M_id.load(std::memory_order_relaxed);
+            call = rpSlot->_M_call.load(std::memory_order_relaxed);
+            cpu = clock_gettime(rpSlot->_M_cpuClock, &ts) == 0 ? (long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000 : 0;
+            cpu -= rpSlot->_M_callStartCpu.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (rpSlot->_M_callStart.load(std::memory_order_relaxed) != start) {
+                // the call ended meanwhile
+                continue;
+            }
+            running = false;
+            handler(id != nullptr ? id : "?", call != nullptr ? call : "?", wall, cpu);
+            return;
+        }
+    }
+}
+
+PlayerClock::PlayerClock()
+    : _pControl(nullptr)
+    , _pHistogram(nullptr)
+    , _id(nullptr)
+    , _pSlot(nullptr)
+    , _gameMicros(0)
+    , _maxCallMicros(0)
+{
+}
+
+/**
+ * @brief Starts measuring the calls of a new game.
+ *
+ * @param pControl - the budgets of the player, nullptr to stop measuring
+ * @param pHistogram - the histogram the calls are added to, nullptr if none
+ * @param id - the id of the algorithm of the player, reported by the watchdog
+ */
+void PlayerClock::reset(const time_control* pControl, latency_histogram* pHistogram, const char* id)
+{
+    _pControl = pControl;
+    _pHistogram = pHistogram;
+    _id = id;
+    // only calls with budgets may hang
+    _pSlot = pControl != nullptr && pControl->isEnabled() ? Watchdog::local() : nullptr;
+    _gameMicros = 0;
+    _maxCallMicros = 0;
+}
+
+/**
+ * @brief Tells if the player went over any of its budgets.
+ *
+ * @return true - if a single call took more than _M_maxCallMicros, or all the calls took more than _M_maxGameMicros
+ * @return false - otherwise, or if not measuring
+ */
+bool PlayerClock::isOverBudget() const
+{
+    if (_pControl == nullptr) {
+        return false;
+    }
+    return (_pControl->_M_maxCallMicros > 0 && _maxCallMicros > _pControl->_M_maxCallMicros)
+        || (_pControl->_M_maxGameMicros > 0 && _gameMicros > _pControl->_M_maxGameMicros);
+}
+
+// counts a game lost on time into the histogram
+void PlayerClock::addForfeit()
+{
+    if (_pHistogram != nullptr) {
+        ++_pHistogram->_M_forfeits;
+    }
+}
+
+/**
+ * @brief Gets the CPU time of the calling thread, the time a player spends in the tournament thread.
+ *
+ * @return long - the time, in microseconds
+ */
+/*static*/ long PlayerClock::now()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (long)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Shows a starting call to the watchdog.
+ *
+ * @param name - the name of the call
+ * @param startCpu - the thread CPU time the call starts
+ */
+void PlayerClock::watch(const char* name, long startCpu)
+{
+    _pSlot->_M_callStartCpu.store(startCpu, std::memory_order_relaxed);
+    _pSlot->_M_id.store(_id, std::memory_order_relaxed);
+    _pSlot->_M_call.store(name, std::memory_order_relaxed);
+    _pSlot->_M_callStart.store(Watchdog::now(), std::memory_order_release);
+}
+
+/**
+ * @brief Adds a measured call.
+ *
+ * @param micros - the time of the call
+ */
+void PlayerClock::add(long micros)
+{
+    _gameMicros += micros;
+    _maxCallMicros = std::max(_maxCallMicros, micros);
+    if (_pHistogram != nullptr) {
+        _pHistogram->add(micros);
+    }
+}
@@ -0,0 +1,192 @@
+/**
+ * @brief The header file of the time control of the players: the budgets, the latency histograms, the PlayerClock class
+ * and the Watchdog of the hung calls.
+ *
+ * @file TimeControl.h
+ * @author Yotam Sechayk
+ * @date 2018-07-14
+ */
+#ifndef __H_TIME_CONTROL
+#define __H_TIME_CONTROL
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+// the number of latency buckets: [0,1) microseconds, then [2^(i-1), 2^i) for bucket i, the last one is open ended
+#define NUM_OF_LATENCY_BUCKETS 24
+// the period of the watchdog checks, in milliseconds
+#define WATCHDOG_PERIOD_MS 10
+// the default wall clock time after which a call is hung, far above any budget (a slow call still returns and loses on time)
+#define WATCHDOG_DEFAULT_TIMEOUT_MS 10000
+
+/**
+ * @brief The CPU time budgets of a player, set per tournament. Both are disabled by default.
+ *
+ */
+struct time_control {
+    long _M_maxCallMicros = 0; // the budget of a single call to the player (0 to disable)
+    long _M_maxGameMicros = 0; // the budget of all the calls to the player in a game (0 to disable)
+    long _M_callTimeoutMicros = 0; // the wall clock time after which a call is hung (0 for WATCHDOG_DEFAULT_TIMEOUT_MS)
+
+    // true iff any of the budgets is enabled
+    bool isEnabled() const { return _M_maxCallMicros > 0 || _M_maxGameMicros > 0 || _M_callTimeoutMicros > 0; }
+};
+
+/**
+ * @brief The latencies of the calls to a player, in buckets of powers of 2 microseconds.
+ *
+ */
+struct latency_histogram {
+    std::array<long, NUM_OF_LATENCY_BUCKETS> _M_buckets {}; // the number of calls in each bucket
+    long _M_calls = 0; // the number of calls
+    long _M_totalMicros = 0; // the time of all the calls
+    long _M_maxMicros = 0; // the time of the slowest call
+    long _M_forfeits = 0; // the number of games lost on time
+
+    // adds a call
+    void add(long micros);
+    // adds the calls of other
+    void merge(const latency_histogram& other);
+    // the upper bound of the bucket holding the percentile (0 to 100) of the calls, in microseconds
+    long getPercentile(double percent) const;
+
+    // the bucket of a latency
+    static int getBucket(long micros);
+    // the upper bound of a bucket, in microseconds
+    static long getBucketLimit(int bucket) { return 1L << bucket; }
+};
+
+/**
+ * @brief The call in progress of a playing thread, as seen by the watchdog.
+ * The call is set before the start (with release semantics), and the start is 0 when the thread isn't in a call.
+ *
+ */
+struct watch_slot {
+    clockid_t _M_cpuClock; // the CPU clock of the thread
+    std::atomic<long> _M_callStart { 0 }; // the wall clock time the call started (microseconds), 0 if not in a call
+    std::atomic<long> _M_callStartCpu { 0 }; // the thread CPU time the call started
+    std::atomic<const char*> _M_id { nullptr }; // the id of the called algorithm
+    std::atomic<const char*> _M_call { nullptr }; // the name of the call
+};
+
+/**
+ * @brief A thread checking the calls in progress of all the playing threads every WATCHDOG_PERIOD_MS.
+ * A player over its budget loses when its call returns, so the watchdog only handles the calls that don't return:
+ * a call is hung once it ran for the wall clock timeout, which isn't derived from the budgets so a descheduled or
+ * slow call is never taken as hung. The CPU clock of the thread tells if the hung call spins or is blocked.
+ * A hung call can't be stopped, so the handler is called (once) to end the tournament.
+ *
+ */
+class Watchdog {
+public:
+    // handles a hung call: the algorithm, the name of the call, and the wall clock and CPU time of the call so far
+    using HangHandler = std::function<void(const char* id, const char* call, long wallMicros, long cpuMicros)>;
+
+private:
+    static std::mutex slotsLock; // guards the slots
+    static std::vector<std::unique_ptr<watch_slot>> slots; // a slot per playing thread, kept until the watchdog stops
+    static std::atomic<bool> running; // true while the watchdog runs
+    static std::atomic<int> generation; // counts the starts, a thread registers again in a new generation
+    static long timeoutMicros; // the wall clock time after which a call is hung
+    static std::thread thread; // the watchdog thread
+    static HangHandler handler; // called on a hung call
+
+public:
+    // starts the watchdog thread, must be called before any game is played
+    static void start(long callTimeoutMicros, HangHandler hangHandler);
+    // stops the watchdog thread, after all the games were played
+    static void stop();
+    // gets the slot of the calling thread (registered on first use), nullptr if the watchdog isn't running
+    static watch_slot* local();
+    // the wall clock time, in microseconds
+    static long now();
+
+private:
+    // the watchdog thread
+    static void run();
+};
+
+/**
+ * @brief Measures the thread CPU time of the calls to a single player in a game, and tells when the player
+ * is over its budget. Every call is also added to the histogram of the player, if given.
+ * A call is measured when it returns, a call that never returns is left to the Watchdog.
+ *
+ */
+class PlayerClock {
+private:
+    const time_control* _pControl; // the budgets, nullptr when not measuring
+    latency_histogram* _pHistogram; // the histogram of the player, nullptr if none
+    const char* _id; // the id of the algorithm of the player, for the watchdog
+    watch_slot* _pSlot; // the watchdog slot of the thread, nullptr if there is no watchdog
+    long _gameMicros; // the time of all the calls so far
+    long _maxCallMicros; // the time of the slowest call so far
+
+public:
+    // basic c'tor, not measuring
+    PlayerClock();
+
+    // starts measuring a game (pControl nullptr to stop measuring)
+    void reset(const time_control* pControl, latency_histogram* pHistogram, const char* id = nullptr);
+    // true iff a call or all the calls so far took more than their budget
+    bool isOverBudget() const;
+    // counts a game lost on time
+    void addForfeit();
+
+    /**
+     * @brief Calls the player and measures the call.
+     *
+     * @tparam CALL - a callable calling the player
+     * @param name - the name of the call, for the watchdog
+     * @param call - the call
+     * @return the result of the call
+     */
+    template <typename CALL>
+    auto call(const char* name, CALL call) -> decltype(call())
+    {
+        timer measure(*this, name);
+        return call();
+    }
+
+    // the thread CPU time, in microseconds
+    static long now();
+
+private:
+    // measures a scope
+    class timer {
+    private:
+        PlayerClock& _clock;
+        long _start;
+
+    public:
+        timer(PlayerClock& clock, const char* name)
+            : _clock(clock)
+            , _start(clock._pControl != nullptr ? now() : 0)
+        {
+            if (_clock._pSlot != nullptr) {
+                _clock.watch(name, _start);
+            }
+        }
+        ~timer()
+        {
+            if (_clock._pSlot != nullptr) {
+                _clock._pSlot->_M_callStart.store(0, std::memory_order_release);
+            }
+            if (_clock._pControl != nullptr) {
+                _clock.add(now() - _start);
+            }
+        }
+    };
+
+    // adds a measured call
+    void add(long micros);
+    // shows a starting call to the watchdog
+    void watch(const char* name, long startCpu);
+};
+
+#endif // !__H_TIME_CONTROL
@@ -7,6 +7,7 @@
  */
 #include "TournamentManager.h"
 #include "GameManagerRPS.h"
+#include "GameRecordWriter.h"
 
 #include <algorithm>
 #include <random>
@@ -83,10 +84,42 @@ void TournamentManager::getSortedScores(std::vector<std::pair<std::string, int>>
 
 void TournamentManager::playMatch(std::string id_p1, std::string id_p2)
 {
-    int gameResult = GameManager::get().PlayRPS(this->getPlayer(id_p1), this->getPlayer(id_p2));
+    int gameResult;
+    game_timing timing;
+    game_timing* pTiming = nullptr;
+
+    if (this->timeControl.isEnabled() || this->latencyReport) {
+        // every call to the players is measured, and a player over its budgets loses
+        timing._M_control = this->timeControl;
+        timing._M_ids[PLAYER_1 - 1] = id_p1.c_str();
+        timing._M_ids[PLAYER_2 - 1] = id_p2.c_str();
+        pTiming = &timing;
+    }
+    if (GameRecordWriter::isEnabled()) {
+        // a record per thread, reused so recording doesn't allocate once warmed up
+        static thread_local GameRecord record;
+        record.clear();
+        record.setPlayers(id_p1, id_p2);
+        gameResult = GameManager::get().PlayRPS(this->getPlayer(id_p1), this->getPlayer(id_p2), &record, this->drawRules, pTiming);
+        GameRecordWriter::local().write(record);
+    } else {
+        gameResult = GameManager::get().PlayRPS(this->getPlayer(id_p1), this->getPlayer(id_p2), nullptr, this->drawRules, pTiming);
+    }
+    if (pTiming != nullptr) {
+        this->updateLatencies(id_p1, id_p2, timing._M_latency);
+    }
     this->updateScores(id_p1, id_p2, gameResult);
 }
 
+void TournamentManager::updateLatencies(const std::string& id_p1, const std::string& id_p2, const latency_histogram (&latencies)[NUM_OF_PLAYERS])
+{
+    // the latencies are kept with the scores
+    std::lock_guard<std::mutex> lock(this->scoreLock);
+
+    this->id2Latency[id_p1].merge(latencies[PLAYER_1 - 1]);
+    this->id2Latency[id_p2].merge(latencies[PLAYER_2 - 1]);
+}
+
 void TournamentManager::updateScores(std::string id_p1, std::string id_p2, int winner)
 {
     // lock the score board
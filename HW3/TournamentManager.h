@@ -8,8 +8,10 @@
 #ifndef __TOURNAMENT_MANAGER_H_
 #define __TOURNAMENT_MANAGER_H_
 
+#include "DrawDetector.h"
 #include "GameUtilitiesRPS.h"
 #include "PlayerAlgorithm.h"
+#include "TimeControl.h"
 
 #include <atomic>
 #include <functional>
@@ -39,6 +41,10 @@ private:
     std::map<std::string, int> id2Score;
     std::map<std::string, int> id2GameNum;
     std::queue<std::pair<std::string, std::string>> pairsOfPlayersQueue;
+    draw_rules drawRules; // the rules ending the games early as draws
+    time_control timeControl; // the budgets of the players
+    bool latencyReport = false; // true iff the players are measured without budgets
+    std::map<std::string, latency_histogram> id2Latency; // the latencies of the calls to each algorithm
 
     std::mutex scoreLock;
 
@@ -53,10 +59,20 @@ public:
     void getSortedScores(std::vector<std::pair<std::string, int>>& finalScores);
     // update the player scores based on the play winner
     void updateScores(std::string id_p1, std::string id_p2, int winner);
+    // returns the ids of all the registered algorithms
+    const std::vector<std::string>& getAlgorithmIds() const { return soIds; }
     // returns a player from id
     std::unique_ptr<PlayerAlgorithm> getPlayer(std::string id) {
         return this->id2Factory[id]();
     }
+    // sets the rules ending the games early as draws, must be called before any game is played
+    void setDrawRules(const draw_rules& rRules) { this->drawRules = rRules; }
+    // sets the budgets of the players, must be called before any game is played
+    void setTimeControl(const time_control& rControl) { this->timeControl = rControl; }
+    // measures the players even without budgets, must be called before any game is played
+    void enableLatencyReport() { this->latencyReport = true; }
+    // gets the latencies of the calls to each algorithm (empty if the players weren't measured)
+    const std::map<std::string, latency_histogram>& getLatencies() const { return id2Latency; }
     // play a match between players
     void playMatch(std::string id_p1, std::string id_p2);
     // returns the play queue
@@ -68,6 +84,8 @@ private:
     // arranges and updates fights for the player with id (name)
     void getFightsForPlayer(std::string name, 
     std::set<std::pair<std::string, std::string>>& playSet);
+    // adds the latencies of the players of a game
+    void updateLatencies(const std::string& id_p1, const std::string& id_p2, const latency_histogram (&latencies)[NUM_OF_PLAYERS]);
     // update the score of a player by id, when needed
     void updateScoreForId(std::string id, int score) {
         if (id2GameNum[id] < NUM_OF_OPP) {
@@ -0,0 +1,292 @@
+/**
+ * @brief The occupancy index policies of the GameBoard class.
+ *
+ * @file BoardIndex.h
+ * @author Yotam Sechayk
+ * @date 2018-06-25
+ */
+#ifndef __BOARD_INDEX_H_
+#define __BOARD_INDEX_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A set of cell indexes in [0, SIZE), sized by its cells: up to SMALL_SIZE cells are kept as a sorted vector,
+ * a larger set as a two level bitmap: a bit per cell, and a summary bit per 64 cells telling if any of them is set.
+ * Finding the next cell in a bitmap scans 4096 cells per summary word, so a sparse set over a large board is walked
+ * in a few steps. The bitmap is allocated when the set grows over SMALL_SIZE cells, and released when it empties.
+ *
+ * @tparam SIZE - the number of cells
+ */
+template <int SIZE>
+class CellSet {
+private:
+    static constexpr int NUM_OF_WORDS = (SIZE + 63) / 64;
+    static constexpr int NUM_OF_SUMMARY_WORDS = (NUM_OF_WORDS + 63) / 64;
+    static constexpr int SMALL_SIZE = 64;
+
+    std::vector<int> _small; // the cells of the set, sorted (only while there is no bitmap)
+    std::vector<std::uint64_t> _words; // bit i is set iff cell i is in the set (empty while the set is small)
+    std::vector<std::uint64_t> _summary; // bit w is set iff _words[w] isn't zero
+    int _count = 0; // the number of cells in the set
+
+public:
+    // the number of cells in the set
+    int size() const { return _count; }
+
+    // adds a cell to the set
+    void insert(int index)
+    {
+        if (_words.empty()) {
+            auto it = std::lower_bound(_small.begin(), _small.end(), index);
+            if (it != _small.end() && *it == index) {
+                return;
+            }
+            if (_count < SMALL_SIZE) {
+                _small.insert(it, index);
+                ++_count;
+                return;
+            }
+            // too large for the vector, moved to a bitmap
+            _words.assign(NUM_OF_WORDS, 0);
+            _summary.assign(NUM_OF_SUMMARY_WORDS, 0);
+            _count = 0;
+            for (int cell : _small) {
+                insertBit(cell);
+            }
+            _small.clear();
+        }
+        insertBit(index);
+    }
+
+    // removes a cell from the set
+    void erase(int index)
+    {
+        if (_words.empty()) {
+            auto it = std::lower_bound(_small.begin(), _small.end(), index);
+            if (it != _small.end() && *it == index) {
+                _small.erase(it);
+                --_count;
+            }
+            return;
+        }
+        std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        if ((_words[index >> 6] & bit) != 0) {
+            _words[index >> 6] &= ~bit;
+            if (_words[index >> 6] == 0) {
+                _summary[index >> 12] &= ~(std::uint64_t(1) << ((index >> 6) & 63));
+            }
+            if (--_count == 0) {
+                // back to a small set, the bitmap is allocated again only if it grows over SMALL_SIZE cells
+                std::vector<std::uint64_t>().swap(_words);
+                std::vector<std::uint64_t>().swap(_summary);
+            }
+        }
+    }
+
+    // empties the set (keeps its memory, for a board filled again)
+    void clear()
+    {
+        _small.clear();
+        for (int s = 0; s < (int)_summary.size(); ++s) {
+            for (std::uint64_t bits = _summary[s]; bits != 0; bits &= bits - 1) {
+                _words[(s << 6) + __builtin_ctzll(bits)] = 0;
+            }
+            _summary[s] = 0;
+        }
+        _count = 0;
+    }
+
+    /**
+     * @brief Gets the first cell of the set, starting at index.
+     *
+     * @param index - the cell index to start from
+     * @return int - the first cell in the set >= index, SIZE if there is none
+     */
+    int next(int index) const
+    {
+        int word = index >> 6;
+        int summaryWord;
+        std::uint64_t bits;
+
+        if (index >= SIZE || _count == 0) {
+            return SIZE;
+        }
+        if (_words.empty()) {
+            auto it = std::lower_bound(_small.begin(), _small.end(), index);
+            return it == _small.end() ? SIZE : *it;
+        }
+        bits = _words[word] & (~std::uint64_t(0) << (index & 63));
+        if (bits != 0) {
+            return (word << 6) + __builtin_ctzll(bits);
+        }
+        // the next non zero word, through the summary
+        if (++word >= NUM_OF_WORDS) {
+            return SIZE;
+        }
+        summaryWord = word >> 6;
+        bits = _summary[summaryWord] & (~std::uint64_t(0) << (word & 63));
+        while (bits == 0) {
+            if (++summaryWord >= NUM_OF_SUMMARY_WORDS) {
+                return SIZE;
+            }
+            bits = _summary[summaryWord];
+        }
+        word = (summaryWord << 6) + __builtin_ctzll(bits);
+        return (word << 6) + __builtin_ctzll(_words[word]);
+    }
+
+private:
+    // sets the bit of a cell in the bitmap
+    void insertBit(int index)
+    {
+        std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        if ((_words[index >> 6] & bit) == 0) {
+            _words[index >> 6] |= bit;
+            _summary[index >> 12] |= std::uint64_t(1) << ((index >> 6) & 63);
+            ++_count;
+        }
+    }
+};
+
+/**
+ * @brief Tells if std::hash can hash T.
+ *
+ */
+template <typename T, typename = void>
+struct is_hashable : std::false_type {
+};
+template <typename T>
+struct is_hashable<T, decltype(std::hash<T>()(std::declval<const T&>()), void())> : std::true_type {
+};
+
+/**
+ * @brief The default index policy: no index. Filtered iterations scan all the occupied cells.
+ *
+ * An index policy provides: insert(index, player, piece), erase(index, player, piece), clear(),
+ * and the constants HAS_PLAYER_INDEX and HAS_PIECE_INDEX. When a constant is true, cellsOfPlayer(player)
+ * or cellsOfPiece(piece) return the cells of the player or of the piece value (nullptr if there are none).
+ *
+ */
+template <int SIZE, typename GAME_PIECE, int PLAYERS>
+class NoIndex {
+public:
+    static constexpr bool HAS_PLAYER_INDEX = false;
+    static constexpr bool HAS_PIECE_INDEX = false;
+
+    void insert(int, int, const GAME_PIECE&) {}
+    void erase(int, int, const GAME_PIECE&) {}
+    void clear() {}
+    const CellSet<SIZE>* cellsOfPlayer(int) const { return nullptr; }
+    const CellSet<SIZE>* cellsOfPiece(const GAME_PIECE&) const { return nullptr; }
+};
+
+/**
+ * @brief An occupancy index: a CellSet per player, and a CellSet per piece value when GAME_PIECE is hashable.
+ * Kept up to date by the board on every change, so filtered iterations jump straight to the matching cells.
+ * The set of a piece value that left the board is kept, so replacing or moving a piece doesn't allocate, and
+ * the emptied sets are dropped once they outnumber half of the sets (plus PURGE_SLACK).
+ * Piece values are matched with std::hash and operator== (for const char* that is the pointer, same as the board filters).
+ *
+ */
+template <int SIZE, typename GAME_PIECE, int PLAYERS>
+class OccupancyIndex {
+public:
+    static constexpr bool HAS_PLAYER_INDEX = true;
+    static constexpr bool HAS_PIECE_INDEX = is_hashable<GAME_PIECE>::value;
+
+private:
+    // the hash of the pieces, never used when the pieces aren't hashable
+    struct piece_hash {
+        template <typename T = GAME_PIECE>
+        typename std::enable_if<is_hashable<T>::value, std::size_t>::type operator()(const T& piece) const { return std::hash<T>()(piece); }
+        template <typename T = GAME_PIECE>
+        typename std::enable_if<!is_hashable<T>::value, std::size_t>::type operator()(const T&) const { return 0; }
+    };
+
+    static constexpr std::size_t PURGE_SLACK = 64;
+
+    std::array<CellSet<SIZE>, PLAYERS> _players; // the cells of each player
+    std::unordered_map<GAME_PIECE, CellSet<SIZE>, piece_hash> _pieces; // the cells of each piece value (only if hashable)
+    std::size_t _numOfEmpty = 0; // the number of empty sets in _pieces
+
+public:
+    void insert(int index, int player, const GAME_PIECE& piece)
+    {
+        _players[player].insert(index);
+        insertPiece(index, piece, std::integral_constant<bool, HAS_PIECE_INDEX>());
+    }
+
+    void erase(int index, int player, const GAME_PIECE& piece)
+    {
+        _players[player].erase(index);
+        erasePiece(index, piece, std::integral_constant<bool, HAS_PIECE_INDEX>());
+    }
+
+    void clear()
+    {
+        for (auto& cells : _players) {
+            cells.clear();
+        }
+        _pieces.clear();
+        _numOfEmpty = 0;
+    }
+
+    const CellSet<SIZE>* cellsOfPlayer(int player) const
+    {
+        return player < 0 || player >= PLAYERS ? nullptr : &_players[player];
+    }
+
+    const CellSet<SIZE>* cellsOfPiece(const GAME_PIECE& piece) const
+    {
+        return findPiece(piece, std::integral_constant<bool, HAS_PIECE_INDEX>());
+    }
+
+private:
+    // the piece index is only kept for hashable pieces
+    void insertPiece(int index, const GAME_PIECE& piece, std::true_type)
+    {
+        auto it = _pieces.find(piece);
+        if (it == _pieces.end()) {
+            it = _pieces.emplace(piece, CellSet<SIZE>()).first;
+        } else if (it->second.size() == 0) {
+            --_numOfEmpty;
+        }
+        it->second.insert(index);
+    }
+    void insertPiece(int, const GAME_PIECE&, std::false_type) {}
+
+    void erasePiece(int index, const GAME_PIECE& piece, std::true_type)
+    {
+        auto it = _pieces.find(piece);
+        if (it == _pieces.end() || it->second.size() == 0) {
+            return;
+        }
+        it->second.erase(index);
+        if (it->second.size() == 0 && ++_numOfEmpty > _pieces.size() / 2 + PURGE_SLACK) {
+            // too many pieces left the board, their sets are dropped
+            for (it = _pieces.begin(); it != _pieces.end();) {
+                it = it->second.size() == 0 ? _pieces.erase(it) : std::next(it);
+            }
+            _numOfEmpty = 0;
+        }
+    }
+    void erasePiece(int, const GAME_PIECE&, std::false_type) {}
+
+    const CellSet<SIZE>* findPiece(const GAME_PIECE& piece, std::true_type) const
+    {
+        auto it = _pieces.find(piece);
+        return it == _pieces.end() ? nullptr : &it->second;
+    }
+    const CellSet<SIZE>* findPiece(const GAME_PIECE&, std::false_type) const { return nullptr; }
+};
+
+#endif // !__BOARD_INDEX_H_
@@ -0,0 +1,295 @@
+/**
+ * @brief The storage policies of the GameBoard class.
+ *
+ * @file BoardStorage.h
+ * @author Yotam Sechayk
+ * @date 2018-06-24
+ */
+#ifndef __BOARD_STORAGE_H_
+#define __BOARD_STORAGE_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Uninitialized room for N cells. The owning storage constructs a cell when a piece is stored in it and
+ * destroys it when the piece leaves (it knows which cells are alive by its occupancy bits), so the pieces only
+ * need to be move constructible, and an empty cell holds nothing.
+ *
+ * @tparam CELL - the cell type
+ * @tparam N - the number of cells
+ */
+template <typename CELL, int N>
+class CellSlots {
+private:
+    typename std::aligned_storage<sizeof(CELL), alignof(CELL)>::type _slots[N];
+
+public:
+    CellSlots() {}
+    CellSlots(const CellSlots&) = delete;
+    CellSlots& operator=(const CellSlots&) = delete;
+
+    // the cell at index, must be alive
+    CELL& operator[](int index) { return *reinterpret_cast<CELL*>(&_slots[index]); }
+    const CELL& operator[](int index) const { return *reinterpret_cast<const CELL*>(&_slots[index]); }
+
+    // constructs the cell at index, must not be alive
+    void construct(int index, int player, typename CELL::second_type&& piece) { ::new (&_slots[index]) CELL(player, std::move(piece)); }
+    // destroys the cell at index, must be alive
+    void destroy(int index) { (*this)[index].~CELL(); }
+};
+
+/**
+ * @brief A dense storage of the board cells. The pieces are kept inline in a single array (row-major),
+ * next to an occupancy bitmap. Reading and writing a cell never allocates, and iteration skips empty
+ * cells 64 at a time using the bitmap.
+ *
+ * A storage policy provides: find(index), set(index, player, piece), erase(index), next(index) and clear(),
+ * where index is the row-major index of a cell (row * COLS + col).
+ *
+ * @tparam ROWS - the number of rows of the board
+ * @tparam COLS - the number of columns of the board
+ * @tparam GAME_PIECE - the piece type, must be move constructible
+ */
+template <int ROWS, int COLS, typename GAME_PIECE>
+class DenseStorage {
+public:
+    // the piece info kept in a cell: the player and the piece
+    using Cell = std::pair<int, GAME_PIECE>;
+
+private:
+    static constexpr int SIZE = ROWS * COLS;
+    static constexpr int NUM_OF_WORDS = (SIZE + 63) / 64;
+
+    CellSlots<Cell, SIZE> _cells; // the pieces, only occupied cells are constructed
+    std::array<std::uint64_t, NUM_OF_WORDS> _occupied {}; // bit i is set iff cell i holds a piece
+
+public:
+    DenseStorage() {}
+    DenseStorage(const DenseStorage&) = delete;
+    DenseStorage& operator=(const DenseStorage&) = delete;
+    ~DenseStorage() { clear(); }
+
+    /**
+     * @brief Gets the piece info at a cell.
+     *
+     * @param index - the cell index
+     * @return const Cell* - a pointer to the piece info in the storage, nullptr if the cell is empty
+     */
+    const Cell* find(int index) const
+    {
+        return isOccupied(index) ? &_cells[index] : nullptr;
+    }
+    // gets the (modifiable) piece info at a cell, nullptr if the cell is empty
+    Cell* find(int index)
+    {
+        return isOccupied(index) ? &_cells[index] : nullptr;
+    }
+
+    /**
+     * @brief Stores a piece in a cell, replacing the previous piece (if any).
+     *
+     * @param index - the cell index
+     * @param player - the player of the piece
+     * @param piece - the piece, moved into the storage
+     */
+    void set(int index, int player, GAME_PIECE&& piece)
+    {
+        erase(index);
+        _cells.construct(index, player, std::move(piece));
+        _occupied[index >> 6] |= std::uint64_t(1) << (index & 63);
+    }
+
+    /**
+     * @brief Empties a cell.
+     *
+     * @param index - the cell index
+     */
+    void erase(int index)
+    {
+        if (isOccupied(index)) {
+            _occupied[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+            _cells.destroy(index);
+        }
+    }
+
+    /**
+     * @brief Gets the first occupied cell, starting at index.
+     *
+     * @param index - the cell index to start from
+     * @return int - the index of the first occupied cell >= index, ROWS * COLS if there is none
+     */
+    int next(int index) const
+    {
+        int word = index >> 6;
+        std::uint64_t bits;
+
+        if (index >= SIZE) {
+            return SIZE;
+        }
+        bits = _occupied[word] & (~std::uint64_t(0) << (index & 63));
+        while (bits == 0) {
+            if (++word >= NUM_OF_WORDS) {
+                return SIZE;
+            }
+            bits = _occupied[word];
+        }
+        return (word << 6) + __builtin_ctzll(bits);
+    }
+
+    /**
+     * @brief Empties all the cells.
+     *
+     */
+    void clear()
+    {
+        for (int index = next(0); index < SIZE; index = next(index + 1)) {
+            erase(index);
+        }
+    }
+
+private:
+    // true iff the cell holds a piece
+    bool isOccupied(int index) const { return (_occupied[index >> 6] >> (index & 63)) & 1; }
+};
+
+/**
+ * @brief A sparse storage of the board cells, for large boards that are mostly empty. The board is split into
+ * tiles of 64 consecutive cells (row-major), and only the tiles holding pieces are allocated, ordered by their
+ * position. A tile is allocated on its first piece and released with its last one, so the memory depends on the
+ * number of pieces and not on the board area. Cells are found through the ordered tile map (O(log tiles)).
+ *
+ * @tparam ROWS - the number of rows of the board
+ * @tparam COLS - the number of columns of the board
+ * @tparam GAME_PIECE - the piece type, must be move constructible
+ */
+template <int ROWS, int COLS, typename GAME_PIECE>
+class SparseStorage {
+public:
+    // the piece info kept in a cell: the player and the piece
+    using Cell = std::pair<int, GAME_PIECE>;
+
+private:
+    static constexpr int SIZE = ROWS * COLS;
+
+    // 64 consecutive cells
+    struct tile {
+        std::uint64_t _M_occupied = 0; // bit i is set iff cell i of the tile holds a piece
+        CellSlots<Cell, 64> _M_cells; // only the occupied cells are constructed
+
+        tile() {}
+        ~tile()
+        {
+            for (std::uint64_t bits = _M_occupied; bits != 0; bits &= bits - 1) {
+                _M_cells.destroy(__builtin_ctzll(bits));
+            }
+        }
+    };
+
+    std::map<int, tile> _tiles; // the allocated tiles, by tile index (cell index / 64)
+
+public:
+    /**
+     * @brief Gets the piece info at a cell.
+     *
+     * @param index - the cell index
+     * @return const Cell* - a pointer to the piece info in the storage, nullptr if the cell is empty
+     */
+    const Cell* find(int index) const
+    {
+        auto it = _tiles.find(index >> 6);
+        if (it == _tiles.end() || ((it->second._M_occupied >> (index & 63)) & 1) == 0) {
+            return nullptr;
+        }
+        return &it->second._M_cells[index & 63];
+    }
+    // gets the (modifiable) piece info at a cell, nullptr if the cell is empty
+    Cell* find(int index)
+    {
+        return const_cast<Cell*>(static_cast<const SparseStorage*>(this)->find(index));
+    }
+
+    /**
+     * @brief Stores a piece in a cell, replacing the previous piece (if any). Allocates the tile of the cell if needed.
+     *
+     * @param index - the cell index
+     * @param player - the player of the piece
+     * @param piece - the piece, moved into the storage
+     */
+    void set(int index, int player, GAME_PIECE&& piece)
+    {
+        tile& rTile = _tiles[index >> 6];
+        std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        if ((rTile._M_occupied & bit) != 0) {
+            rTile._M_occupied &= ~bit;
+            rTile._M_cells.destroy(index & 63);
+        }
+        rTile._M_cells.construct(index & 63, player, std::move(piece));
+        rTile._M_occupied |= bit;
+    }
+
+    /**
+     * @brief Empties a cell, releasing its tile if it was the last piece in it.
+     *
+     * @param index - the cell index
+     */
+    void erase(int index)
+    {
+        std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        auto it = _tiles.find(index >> 6);
+        if (it == _tiles.end() || (it->second._M_occupied & bit) == 0) {
+            return;
+        }
+        it->second._M_occupied &= ~bit;
+        it->second._M_cells.destroy(index & 63);
+        if (it->second._M_occupied == 0) {
+            _tiles.erase(it);
+        }
+    }
+
+    /**
+     * @brief Gets the first occupied cell, starting at index.
+     *
+     * @param index - the cell index to start from
+     * @return int - the index of the first occupied cell >= index, ROWS * COLS if there is none
+     */
+    int next(int index) const
+    {
+        std::uint64_t bits;
+
+        if (index >= SIZE) {
+            return SIZE;
+        }
+        // the allocated tiles are never empty, so only the tile of index may have no piece from index on
+        auto it = _tiles.lower_bound(index >> 6);
+        if (it != _tiles.end() && it->first == (index >> 6)) {
+            bits = it->second._M_occupied & (~std::uint64_t(0) << (index & 63));
+            if (bits != 0) {
+                return (it->first << 6) + __builtin_ctzll(bits);
+            }
+            ++it;
+        }
+        if (it == _tiles.end()) {
+            return SIZE;
+        }
+        return (it->first << 6) + __builtin_ctzll(it->second._M_occupied);
+    }
+
+    /**
+     * @brief Empties all the cells, releasing all the tiles.
+     *
+     */
+    void clear()
+    {
+        _tiles.clear();
+    }
+
+    // the number of allocated tiles
+    int getNumOfTiles() const { return (int)_tiles.size(); }
+};
+
+#endif // !__BOARD_STORAGE_H_
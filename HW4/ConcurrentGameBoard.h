@@ -0,0 +1,245 @@
+/**
+ * @brief The ConcurrentGameBoard class header file.
+ *
+ * @file ConcurrentGameBoard.h
+ * @author Yotam Sechayk
+ * @date 2018-06-27
+ */
+#ifndef __CONCURRENT_GAME_BOARD_H_
+#define __CONCURRENT_GAME_BOARD_H_
+
+#include "GameBoard.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A board that many threads may read while another thread changes it, guarded by a sequence lock.
+ * A writer makes the sequence odd, changes the cells and makes it even again (with release semantics), so a
+ * reader that saw the same even sequence before and after reading knows it read a consistent board; otherwise
+ * it reads again. Readers never block the writer, and writers are serialized by a mutex.
+ *
+ * Readers may see a cell while it changes (the read is then retried), so every cell is kept in atomics and
+ * the pieces must be trivially copyable (char, const char*, enums, small structs). Iteration is done over a
+ * consistent snapshot, a regular GameBoard with all its views.
+ *
+ */
+template <int ROWS, int COLS, typename GAME_PIECE, int PLAYERS = 2>
+class ConcurrentGameBoard {
+    static_assert(std::is_trivially_copyable<GAME_PIECE>::value, "the pieces of a ConcurrentGameBoard must be trivially copyable");
+
+public:
+    // a consistent copy of the board
+    using Snapshot = GameBoard<ROWS, COLS, GAME_PIECE, PLAYERS>;
+
+private:
+    static constexpr int SIZE = ROWS * COLS;
+    static constexpr int NO_PLAYER = -1;
+
+    // a cell, read by the readers while the writer may change it
+    struct cell {
+        std::atomic<int> _M_player; // NO_PLAYER if the cell is empty
+        std::atomic<GAME_PIECE> _M_piece;
+    };
+
+    std::array<cell, SIZE> _cells;
+    std::atomic<unsigned> _seq { 0 }; // odd while a write is in progress
+    std::mutex _writeLock; // serializes the writers
+
+public:
+    /**
+     * @brief The changes done in a single write, published to the readers together when the write ends.
+     *
+     */
+    class transaction {
+    private:
+        ConcurrentGameBoard& _board;
+
+    public:
+        explicit transaction(ConcurrentGameBoard& board)
+            : _board(board)
+        {
+        }
+
+        // the same as GameBoard::setPiece
+        PieceInfo<GAME_PIECE> setPiece(int row, int col, GAME_PIECE piece, int player)
+        {
+            PieceInfo<GAME_PIECE> prev;
+            if (!isPositionLegal(row, col) || player < 0 || player >= PLAYERS) {
+                return nullptr;
+            }
+            cell& rCell = _board._cells[row * COLS + col];
+            int prevPlayer = rCell._M_player.load(std::memory_order_relaxed);
+            if (prevPlayer != NO_PLAYER) {
+                prev = std::make_unique<std::pair<int, GAME_PIECE>>(prevPlayer, rCell._M_piece.load(std::memory_order_relaxed));
+            }
+            rCell._M_piece.store(piece, std::memory_order_relaxed);
+            rCell._M_player.store(player, std::memory_order_relaxed);
+            return prev;
+        }
+
+        // empties a cell, returns the piece info of the removed piece (nullptr if none)
+        PieceInfo<GAME_PIECE> removePiece(int row, int col)
+        {
+            if (!isPositionLegal(row, col)) {
+                return nullptr;
+            }
+            cell& rCell = _board._cells[row * COLS + col];
+            int prevPlayer = rCell._M_player.load(std::memory_order_relaxed);
+            if (prevPlayer == NO_PLAYER) {
+                return nullptr;
+            }
+            rCell._M_player.store(NO_PLAYER, std::memory_order_relaxed);
+            return std::make_unique<std::pair<int, GAME_PIECE>>(prevPlayer, rCell._M_piece.load(std::memory_order_relaxed));
+        }
+
+        // the same as GameBoard::getPiece, sees the changes of the transaction
+        PieceInfo<GAME_PIECE> getPiece(int row, int col) const
+        {
+            if (!isPositionLegal(row, col)) {
+                return nullptr;
+            }
+            const cell& rCell = _board._cells[row * COLS + col];
+            int player = rCell._M_player.load(std::memory_order_relaxed);
+            if (player == NO_PLAYER) {
+                return nullptr;
+            }
+            return std::make_unique<std::pair<int, GAME_PIECE>>(player, rCell._M_piece.load(std::memory_order_relaxed));
+        }
+    };
+
+    ConcurrentGameBoard()
+    {
+        for (auto& rCell : _cells) {
+            rCell._M_player.store(NO_PLAYER, std::memory_order_relaxed);
+            rCell._M_piece.store(GAME_PIECE(), std::memory_order_relaxed);
+        }
+    }
+    ~ConcurrentGameBoard() {}
+
+    ConcurrentGameBoard(const ConcurrentGameBoard&) = delete;
+    ConcurrentGameBoard& operator=(const ConcurrentGameBoard&) = delete;
+
+    /**
+     * @brief Runs a write. All the changes done through the transaction are seen by the readers at once.
+     *
+     * @tparam UPDATE - a callable taking a transaction&
+     * @param update - the changes to make
+     */
+    template <typename UPDATE>
+    void update(UPDATE update)
+    {
+        std::lock_guard<std::mutex> lock(_writeLock);
+        unsigned seq = _seq.load(std::memory_order_relaxed);
+        transaction tx(*this);
+
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        // the odd sequence is visible before any of the changes
+        std::atomic_thread_fence(std::memory_order_release);
+        update(tx);
+        // publish the changes
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief The same as GameBoard::setPiece, as a single write.
+     *
+     * @return PieceInfo<GAME_PIECE> - The previus piece in that place or nullptr if no piece existed or the position isn't valid
+     */
+    PieceInfo<GAME_PIECE> setPiece(int row, int col, GAME_PIECE piece, int player)
+    {
+        PieceInfo<GAME_PIECE> prev;
+        update([&](transaction& tx) { prev = tx.setPiece(row, col, piece, player); });
+        return prev;
+    }
+
+    /**
+     * @brief The same as GameBoard::getPiece. Never blocks, and never sees a cell in the middle of a write.
+     *
+     * @param row - A 0-based row position
+     * @param col - A 0-based column position
+     * @return PieceInfo<GAME_PIECE> - A unique_ptr to the Piece Info object (const pair<int, piece_type>)
+     */
+    PieceInfo<GAME_PIECE> getPiece(int row, int col) const
+    {
+        int player;
+        GAME_PIECE piece;
+
+        if (!isPositionLegal(row, col)) {
+            return nullptr;
+        }
+        const cell& rCell = _cells[row * COLS + col];
+        read([&] {
+            player = rCell._M_player.load(std::memory_order_relaxed);
+            piece = rCell._M_piece.load(std::memory_order_relaxed);
+        });
+        if (player == NO_PLAYER) {
+            return nullptr;
+        }
+        return std::make_unique<std::pair<int, GAME_PIECE>>(player, piece);
+    }
+
+    /**
+     * @brief Copies the board as it was between two writes. The copy may then be iterated (and filtered) freely.
+     * A read of a large board is retried as long as writes keep landing in the middle of it.
+     *
+     * @return std::unique_ptr<Snapshot> - the copy
+     */
+    std::unique_ptr<Snapshot> snapshot() const
+    {
+        std::vector<std::pair<int, GAME_PIECE>> cells(SIZE);
+        auto copy = std::make_unique<Snapshot>();
+
+        read([&] {
+            for (int i = 0; i < SIZE; ++i) {
+                cells[i].first = _cells[i]._M_player.load(std::memory_order_relaxed);
+                cells[i].second = _cells[i]._M_piece.load(std::memory_order_relaxed);
+            }
+        });
+        for (int i = 0; i < SIZE; ++i) {
+            if (cells[i].first != NO_PLAYER) {
+                copy->placePiece(i / COLS, i % COLS, cells[i].second, cells[i].first);
+            }
+        }
+        return copy;
+    }
+
+    // the number of writes done so far
+    unsigned getVersion() const { return _seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    /**
+     * @brief Runs a read until it doesn't overlap a write.
+     *
+     * @tparam READ - a callable reading the cells with relaxed loads
+     * @param read - the read, may run more than once
+     */
+    template <typename READ>
+    void read(READ read) const
+    {
+        unsigned before, after;
+        do {
+            while ((before = _seq.load(std::memory_order_acquire)) & 1) {
+                std::this_thread::yield();
+            }
+            read();
+            // the reads are done before the sequence is checked again
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _seq.load(std::memory_order_relaxed);
+        } while (before != after);
+    }
+
+    // only if 0 <= row < ROWS, 0 <= col < COLS
+    static bool isPositionLegal(int row, int col)
+    {
+        return row >= 0 && row < ROWS && col >= 0 && col < COLS;
+    }
+};
+
+#endif // !__CONCURRENT_GAME_BOARD_H_
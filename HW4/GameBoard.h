@@ -1,6 +1,6 @@
 /**
  * @brief The GameBoard class header file.
- * 
+ *
  * @file GameBoard.h
  * @author Yotam Sechayk
  * @date 2018-06-20
@@ -8,93 +8,170 @@
 #ifndef __GAME_BOARD_H_
 #define __GAME_BOARD_H_
 
+#include "BoardIndex.h"
+#include "BoardStorage.h"
+
 #include <array>
-#include <functional>
 #include <memory>
+#include <tuple>
+#include <utility>
 
 // the Piece Info element
 template <typename GAME_PIECE>
 using PieceInfo = std::unique_ptr<const std::pair<int, GAME_PIECE>>;
 
-template <int ROWS, int COLS, typename GAME_PIECE, int PLAYERS = 2>
+/**
+ * @brief A board of ROWS x COLS cells, each holding at most a single piece of one of PLAYERS players.
+ * The pieces are kept by the STORAGE policy (inline by default, SparseStorage for large boards that are mostly empty,
+ * see BoardStorage.h). getPiece and setPiece return allocated copies for compatibility, findPiece and placePiece
+ * access the storage without allocating.
+ * The filtered iterations (allPiecesOfPlayer, allOccureneceOfPiece, allOccureneceOfPieceForPlayer and filter) return
+ * views that carry their own predicate, so they may be nested, left early and used from several threads.
+ * With an INDEX policy (OccupancyIndex, see BoardIndex.h) the per-player and per-piece views jump straight to the
+ * matching cells instead of scanning every occupied cell, at the cost of updating the index on every change.
+ *
+ */
+template <int ROWS, int COLS, typename GAME_PIECE, int PLAYERS = 2, template <int, int, typename> class STORAGE = DenseStorage,
+    template <int, typename, int> class INDEX = NoIndex>
 class GameBoard {
 private:
-    std::array<PieceInfo<GAME_PIECE>, ROWS * COLS> _board;
+    using Storage = STORAGE<ROWS, COLS, GAME_PIECE>;
+    using Index = INDEX<ROWS * COLS, GAME_PIECE, PLAYERS>;
+    using Cells = CellSet<ROWS * COLS>;
+    using Cell = std::pair<int, GAME_PIECE>;
+
+    Storage _board;
+    Index _index;
 
 public:
     GameBoard() {}
     ~GameBoard() {}
 
-    class iterator {
+    // accepts every piece
+    struct all_pieces {
+        bool operator()(const Cell&) const { return true; }
+    };
+    // accepts the pieces of a player
+    struct pieces_of_player {
+        int _M_player;
+        bool operator()(const Cell& cell) const { return cell.first == _M_player; }
+    };
+    // accepts the occurrences of a piece
+    struct occurrences_of_piece {
+        GAME_PIECE _M_piece;
+        bool operator()(const Cell& cell) const { return cell.second == _M_piece; }
+    };
+    // accepts the occurrences of a piece of a player
+    struct occurrences_of_piece_for_player {
+        GAME_PIECE _M_piece;
+        int _M_player;
+        bool operator()(const Cell& cell) const { return cell.first == _M_player && cell.second == _M_piece; }
+    };
+
+    /**
+     * @brief An iterator over the occupied cells that pass the PREDICATE, in row-major order.
+     * The predicate is kept in the iterator, there is no shared state between iterations.
+     * When given the indexed cells of the filter, only those cells are visited (they still have to pass the predicate).
+     *
+     */
+    template <typename PREDICATE>
+    class filter_iterator {
     private:
-        PieceInfo<GAME_PIECE>* _pos;
+        const Storage* _storage;
+        const Cells* _cells; // the candidate cells, nullptr for all the occupied cells
         int _loc;
-        static std::function<bool(const std::pair<int, GAME_PIECE>&)> filter;
+        PREDICATE _pred;
 
     public:
-        iterator(PieceInfo<GAME_PIECE>* pos = nullptr, int loc = 0)
-            : _pos(pos)
+        filter_iterator(const Storage* storage = nullptr, int loc = ROWS * COLS, PREDICATE pred = PREDICATE(), const Cells* cells = nullptr)
+            : _storage(storage)
+            , _cells(cells)
             , _loc(loc)
+            , _pred(std::move(pred))
         {
-            auto r = *_pos == nullptr ? false : filter(*(*_pos));
-            while (!r && _loc < ROWS * COLS) {
-                ++_pos;
-                ++_loc;
-                r = *_pos == nullptr ? false : filter(*(*_pos));
+            if (_loc < ROWS * COLS) {
+                skip();
             }
         }
-        std::tuple<int, int, GAME_PIECE, int> operator*() { return std::make_tuple(row(_loc), col(_loc), (*_pos)->second, (*_pos)->first); }
-        iterator operator++()
+        std::tuple<int, int, GAME_PIECE, int> operator*() const
         {
-            bool r;
-            do {
-                ++_pos;
-                ++_loc;
-                r = *_pos == nullptr ? false : filter(*(*_pos));
-            } while (!r && _loc < COLS * ROWS);
-            // if reached the end, reset the filter
-            if (_loc >= COLS * ROWS) {
-                filter = [](const std::pair<int, GAME_PIECE>&) { return true; };
-            }
-            return iterator(_pos, _loc);
+            const Cell& cell = *_storage->find(_loc);
+            return std::make_tuple(row(_loc), col(_loc), cell.second, cell.first);
         }
-        bool operator!=(iterator other) const { return _pos != other._pos; }
-        // set the filter of the iterator
-        static void setFilter(std::function<bool(const std::pair<int, GAME_PIECE>&)> f)
+        filter_iterator& operator++()
         {
-            filter = f;
+            ++_loc;
+            skip();
+            return *this;
         }
+        bool operator!=(const filter_iterator& other) const { return _loc != other._loc; }
+        bool operator==(const filter_iterator& other) const { return _loc == other._loc; }
 
     private:
-        int row(int loc) { return loc / COLS; }
-        int col(int loc) { return loc % COLS; }
+        static int row(int loc) { return loc / COLS; }
+        static int col(int loc) { return loc % COLS; }
+        // the first candidate cell >= loc
+        int seek(int loc) const { return _cells != nullptr ? _cells->next(loc) : _storage->next(loc); }
+        // moves to the first occupied cell (from the current one) that passes the predicate
+        void skip()
+        {
+            _loc = seek(_loc);
+            while (_loc < ROWS * COLS && !_pred(*_storage->find(_loc))) {
+                _loc = seek(_loc + 1);
+            }
+        }
     };
+
+    /**
+     * @brief A range over the pieces of a board that pass the PREDICATE. Holds a pointer to the board and the predicate,
+     * so any number of views can be iterated at once (also from several threads, as long as the board isn't changed).
+     *
+     */
+    template <typename PREDICATE>
+    class filter_view {
+    private:
+        const Storage* _storage;
+        const Cells* _cells;
+        PREDICATE _pred;
+
+    public:
+        filter_view(const Storage* storage, PREDICATE pred, const Cells* cells = nullptr)
+            : _storage(storage)
+            , _cells(cells)
+            , _pred(std::move(pred))
+        {
+        }
+        filter_iterator<PREDICATE> begin() const { return filter_iterator<PREDICATE>(_storage, 0, _pred, _cells); }
+        filter_iterator<PREDICATE> end() const { return filter_iterator<PREDICATE>(_storage, ROWS * COLS, _pred, _cells); }
+    };
+
+    // the iterator over all the pieces of the board
+    using iterator = filter_iterator<all_pieces>;
+
     // begin iterator
-    iterator begin() { return iterator(&_board.at(0), 0); }
+    iterator begin() const { return iterator(&_board, 0); }
     // end iterator
-    iterator end() { return iterator(&_board.at(ROWS * COLS - 1) + 1, ROWS * COLS); }
+    iterator end() const { return iterator(&_board, ROWS * COLS); }
 
     /**
      * @brief Get the Piece Info object at positiong (row,col). If no piece exists in that position, returns nullptr.
-     * 
+     *
      * @param row - A 0-based row position
      * @param col - A 0-based column position
      * @return PieceInfo<GAME_PIECE> - A unique_ptr to the Piece Info object (const pair<int, piece_type>)
      */
-    PieceInfo<GAME_PIECE> getPiece(int row, int col)
+    PieceInfo<GAME_PIECE> getPiece(int row, int col) const
     {
-        if (!isPositionLegal(row, col)) {
+        const Cell* cell = findPiece(row, col);
+        if (cell == nullptr) {
             return nullptr;
         }
-        if (_board[row * COLS + col] == nullptr) {
-            return nullptr;
-        }
-        return std::move(std::make_unique<std::pair<int, GAME_PIECE>>(_board[row * COLS + col]->first, _board[row * COLS + col]->second));
+        return std::make_unique<Cell>(*cell);
     }
 
     /**
      * @brief Insert a Piece Info object into the board. If a piece was already in the insertion place, it overwrites it. Returns nullptr if no piece was present, otherwise the Piece Info object of the previus piece.
-     * 
+     *
      * @param row - A 0-based row position
      * @param col - A 0-based column position
      * @param piece - The piece itself, assuming same type as the board piece type
@@ -103,45 +180,224 @@ public:
      */
     PieceInfo<GAME_PIECE> setPiece(int row, int col, GAME_PIECE piece, int player)
     {
-        if (!isPositionLegal(row, col)) {
+        PieceInfo<GAME_PIECE> prev_piece;
+        if (!isPositionLegal(row, col) || player < 0 || player >= PLAYERS) {
             return nullptr;
         }
-        if (player < 0 || player >= PLAYERS) {
+        storePiece(row * COLS + col, player, std::move(piece), &prev_piece);
+        return prev_piece;
+    }
+
+    /**
+     * @brief The same as setPiece, with the piece constructed from args. The new piece is moved into the board and the
+     * previous piece is moved out of it, so neither is copied.
+     *
+     * @param row - A 0-based row position
+     * @param col - A 0-based column position
+     * @param player - the player which the piece belongs to
+     * @param args - the arguments of the piece constructor
+     * @return PieceInfo<GAME_PIECE> - The previus piece in that place or nullptr if no piece existed or the position isn't valid
+     */
+    template <typename... ARGS>
+    PieceInfo<GAME_PIECE> emplacePiece(int row, int col, int player, ARGS&&... args)
+    {
+        return setPiece(row, col, GAME_PIECE(std::forward<ARGS>(args)...), player);
+    }
+
+    /**
+     * @brief Get the Piece Info at position (row,col) without copying it.
+     *
+     * @param row - A 0-based row position
+     * @param col - A 0-based column position
+     * @return const std::pair<int, GAME_PIECE>* - A pointer to the piece info in the board (valid until the cell changes), nullptr if no piece exists or the position isn't valid
+     */
+    const std::pair<int, GAME_PIECE>* findPiece(int row, int col) const
+    {
+        if (!isPositionLegal(row, col)) {
             return nullptr;
         }
-        auto prev_piece = getPiece(row, col);
-        _board[row * COLS + col] = std::make_unique<std::pair<int, GAME_PIECE>>(player, piece);
-        return std::move(prev_piece);
+        return _board.find(row * COLS + col);
+    }
+
+    /**
+     * @brief Insert a piece into the board, overwriting the piece in the insertion place (if any). Doesn't allocate.
+     *
+     * @param row - A 0-based row position
+     * @param col - A 0-based column position
+     * @param piece - The piece itself, moved into the board
+     * @param player - the player which the piece belongs to
+     * @return true - if the piece was placed
+     * @return false - if the position or the player isn't valid
+     */
+    bool placePiece(int row, int col, GAME_PIECE piece, int player)
+    {
+        if (!isPositionLegal(row, col) || player < 0 || player >= PLAYERS) {
+            return false;
+        }
+        storePiece(row * COLS + col, player, std::move(piece), nullptr);
+        return true;
+    }
+
+    /**
+     * @brief Moves a piece to another cell, overwriting the piece there (if any). The piece is moved, not copied.
+     *
+     * @param fromRow - A 0-based row position of the piece
+     * @param fromCol - A 0-based column position of the piece
+     * @param toRow - A 0-based row position to move to
+     * @param toCol - A 0-based column position to move to
+     * @param pPrev - if not nullptr, set to the Piece Info of the overwritten piece (nullptr if there was none)
+     * @return true - if the piece was moved (or the positions are the same)
+     * @return false - if a position isn't valid or there is no piece to move
+     */
+    bool movePiece(int fromRow, int fromCol, int toRow, int toCol, PieceInfo<GAME_PIECE>* pPrev = nullptr)
+    {
+        if (pPrev != nullptr) {
+            pPrev->reset();
+        }
+        if (!isPositionLegal(fromRow, fromCol) || !isPositionLegal(toRow, toCol)) {
+            return false;
+        }
+        Cell* moved = _board.find(fromRow * COLS + fromCol);
+        if (moved == nullptr) {
+            return false;
+        }
+        if (fromRow == toRow && fromCol == toCol) {
+            return true;
+        }
+        int player = moved->first;
+        GAME_PIECE piece = std::move(moved->second);
+        _index.erase(fromRow * COLS + fromCol, player, piece);
+        _board.erase(fromRow * COLS + fromCol);
+        storePiece(toRow * COLS + toCol, player, std::move(piece), pPrev);
+        return true;
+    }
+
+    /**
+     * @brief Removes all the pieces from the board.
+     *
+     */
+    void clear()
+    {
+        _board.clear();
+        _index.clear();
+    }
+
+    /**
+     * @brief Replaces the content of the board with the pieces of a range of (row, col, piece, player) tuples,
+     * such as the iterators of another board. Tuples with a position or a player that isn't valid are skipped.
+     * The range must not be a view of this board. Moves the pieces out of a range of move iterators.
+     *
+     * @tparam ITERATOR - an input iterator of std::tuple<int, int, GAME_PIECE, int>
+     * @param first - the first tuple
+     * @param last - the end of the range
+     * @return int - the number of pieces placed
+     */
+    template <typename ITERATOR>
+    int assign(ITERATOR first, ITERATOR last)
+    {
+        int count = 0;
+
+        clear();
+        for (; first != last; ++first) {
+            auto&& info = *first;
+            int row = std::get<0>(info), col = std::get<1>(info), player = std::get<3>(info);
+            if (placePiece(row, col, std::get<2>(std::forward<decltype(info)>(info)), player)) {
+                ++count;
+            }
+        }
+        return count;
     }
 
-    GameBoard<ROWS, COLS, GAME_PIECE, PLAYERS>& allPiecesOfPlayer(int playerNum)
+    // a view of all the pieces of a player
+    filter_view<pieces_of_player> allPiecesOfPlayer(int playerNum) const
     {
-        iterator::setFilter([playerNum](const std::pair<int, GAME_PIECE>& p) { return p.first == playerNum; });
-        return *this;
+        return filter_view<pieces_of_player>(&_board, pieces_of_player { playerNum }, playerCells(playerNum));
     }
 
-    GameBoard<ROWS, COLS, GAME_PIECE, PLAYERS>& allOccureneceOfPiece(GAME_PIECE piece)
+    // a view of all the occurrences of a piece
+    filter_view<occurrences_of_piece> allOccureneceOfPiece(GAME_PIECE piece) const
     {
-        iterator::setFilter([piece](const std::pair<int, GAME_PIECE>& p) { return p.second == piece; });
-        return *this;
+        const Cells* cells = pieceCells(piece);
+        return filter_view<occurrences_of_piece>(&_board, occurrences_of_piece { std::move(piece) }, cells);
     }
 
-    GameBoard<ROWS, COLS, GAME_PIECE, PLAYERS>& allOccureneceOfPieceForPlayer(GAME_PIECE piece, int playerNum)
+    // a view of all the occurrences of a piece of a player
+    filter_view<occurrences_of_piece_for_player> allOccureneceOfPieceForPlayer(GAME_PIECE piece, int playerNum) const
+    {
+        const Cells* cells = pieceCells(piece);
+        const Cells* ofPlayer = playerCells(playerNum);
+        // walk the smaller of the two sets
+        if (cells == nullptr || (ofPlayer != nullptr && ofPlayer->size() < cells->size())) {
+            cells = ofPlayer;
+        }
+        return filter_view<occurrences_of_piece_for_player>(&_board, occurrences_of_piece_for_player { std::move(piece), playerNum }, cells);
+    }
+
+    /**
+     * @brief Get a view of the pieces that pass a predicate. The predicate is called with the piece info (const pair<int, piece_type>&)
+     * of every occupied cell, and is inlined into the iteration.
+     *
+     * @tparam PREDICATE - the type of the predicate (usually a lambda)
+     * @param pred - the predicate
+     * @return filter_view<PREDICATE> - the range of the pieces
+     */
+    template <typename PREDICATE>
+    filter_view<PREDICATE> filter(PREDICATE pred) const
     {
-        iterator::setFilter([piece, playerNum](const std::pair<int, GAME_PIECE>& p) { return (p.second == piece && p.first == playerNum); });
-        return *this;
+        return filter_view<PREDICATE>(&_board, std::move(pred));
     }
 
 private:
+    // stores a piece in a legal cell, moving the previous piece (if any) out to pPrev (if not nullptr)
+    void storePiece(int index, int player, GAME_PIECE&& piece, PieceInfo<GAME_PIECE>* pPrev)
+    {
+        Cell* prev = _board.find(index);
+        if (prev != nullptr) {
+            _index.erase(index, prev->first, prev->second);
+            if (pPrev != nullptr) {
+                *pPrev = std::make_unique<Cell>(prev->first, std::move(prev->second));
+            }
+        }
+        _index.insert(index, player, piece);
+        _board.set(index, player, std::move(piece));
+    }
+
+    // the indexed cells of a player, nullptr if the players aren't indexed
+    const Cells* playerCells(int player) const
+    {
+        if (!Index::HAS_PLAYER_INDEX) {
+            return nullptr;
+        }
+        const Cells* cells = _index.cellsOfPlayer(player);
+        return cells != nullptr ? cells : &noCells();
+    }
+
+    // the indexed cells of a piece, nullptr if the pieces aren't indexed
+    const Cells* pieceCells(const GAME_PIECE& piece) const
+    {
+        if (!Index::HAS_PIECE_INDEX) {
+            return nullptr;
+        }
+        const Cells* cells = _index.cellsOfPiece(piece);
+        return cells != nullptr ? cells : &noCells();
+    }
+
+    // an empty set of cells, for the filters that match nothing
+    static const Cells& noCells()
+    {
+        static const Cells empty;
+        return empty;
+    }
+
     /**
      * @brief Checks if the given position is legal and within the board dimensions.
-     * 
+     *
      * @param row - A 0-based row position
      * @param col - A 0-based column position
      * @return true - Only if 0 <= row < ROWS, 0 <= col < COLS
      * @return false - Otherwise
      */
-    bool isPositionLegal(int row, int col)
+    static bool isPositionLegal(int row, int col)
     {
         if (row < 0 || row >= ROWS || col < 0 || col >= COLS) {
             return false;
@@ -150,7 +406,4 @@ private:
     }
 };
 
-template <int ROWS, int COLS, typename GAME_PIECE, int PLAYERS>
-std::function<bool(const std::pair<int, GAME_PIECE>&)> GameBoard<ROWS, COLS, GAME_PIECE, PLAYERS>::iterator::filter = [](const std::pair<int, GAME_PIECE>&) -> bool { return true; };
-
 #endif // !__GAME_BOARD_H_
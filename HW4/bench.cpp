@@ -0,0 +1,248 @@
+/**
+ * @brief The benchmark of the GameBoard template: setPiece/getPiece throughput, full iteration and the filtered
+ * iterations, over several board sizes, densities, piece types and storage policies. Reports the time and the
+ * number of heap allocations per operation.
+ *
+ * @file bench.cpp
+ * @author Yotam Sechayk
+ * @date 2018-06-28
+ */
+#include "ex4_header.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// the number of setPiece / getPiece calls measured per board
+#define NUM_OF_CALLS (1 << 18)
+// the number of pieces visited per iteration benchmark (at least a single pass is made)
+#define NUM_OF_VISITS (1 << 21)
+// the number of different pieces on the boards
+#define NUM_OF_KINDS 6
+
+// the heap allocations done by the process (the benchmark is single threaded)
+static long numOfAllocations = 0;
+// keeps the results of the benchmarks from being optimized away
+static volatile long sink = 0;
+
+// not inlined, the benchmarks should pay for a real call as without the counter
+__attribute__((noinline)) void* operator new(std::size_t size)
+{
+    ++numOfAllocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept { std::free(p); }
+__attribute__((noinline)) void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// the pieces of the benchmarks, by type
+template <typename GAME_PIECE>
+struct piece_maker;
+template <>
+struct piece_maker<char> {
+    static const char* name() { return "char"; }
+    static char make(int kind) { return "RPSBFJ"[kind]; }
+};
+template <>
+struct piece_maker<const char*> {
+    static const char* name() { return "const char*"; }
+    static const char* make(int kind)
+    {
+        static const char* kinds[NUM_OF_KINDS] = { "rock", "paper", "scissors", "bomb", "flag", "joker" };
+        return kinds[kind];
+    }
+};
+template <>
+struct piece_maker<std::string> {
+    static const char* name() { return "std::string"; }
+    // longer than the small string buffer, so every copy allocates (the kinds over NUM_OF_KINDS are numbered)
+    static std::string make(int kind)
+    {
+        return kind < NUM_OF_KINDS ? std::string("game piece of kind ") + "RPSBFJ"[kind] : "game piece number " + std::to_string(kind);
+    }
+};
+
+// a linear congruential generator, the same sequence on every run
+static unsigned nextRandom(unsigned& rSeed)
+{
+    rSeed = rSeed * 1103515245 + 12345;
+    return rSeed >> 8;
+}
+
+/**
+ * @brief Measures a benchmark and prints a result line.
+ *
+ * @tparam BENCHMARK - a callable running the benchmark and returning the number of operations it did
+ * @param prefix - the description of the board
+ * @param name - the name of the operation
+ * @param benchmark - the benchmark
+ */
+template <typename BENCHMARK>
+static void measure(const std::string& prefix, const char* name, BENCHMARK benchmark)
+{
+    long allocations = numOfAllocations;
+    auto start = std::chrono::steady_clock::now();
+    long ops = benchmark();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    allocations = numOfAllocations - allocations;
+
+    if (ops == 0) {
+        std::printf("%s %-14s %10s %10s\n", prefix.c_str(), name, "-", "-");
+    } else {
+        std::printf("%s %-14s %10.2f %10.3f\n", prefix.c_str(), name, ns / ops, (double)allocations / ops);
+    }
+}
+
+/**
+ * @brief Runs all the benchmarks on a board, filled to a density with pieces of every kind of both players.
+ * setPiece replaces random pieces, getPiece reads random cells, and the iterations count the pieces they return.
+ * With more kinds than NUM_OF_KINDS (std::string only) the pieces are mostly unique, a piece value per cell.
+ *
+ */
+template <int ROWS, int COLS, typename GAME_PIECE, template <int, int, typename> class STORAGE, template <int, typename, int> class INDEX>
+static void benchmarkBoard(const char* storageName, int densityPercent, int numOfKinds = NUM_OF_KINDS)
+{
+    using Board = GameBoard<ROWS, COLS, GAME_PIECE, 2, STORAGE, INDEX>;
+    const int size = ROWS * COLS;
+    const GAME_PIECE target = piece_maker<GAME_PIECE>::make(0);
+    auto board = std::make_unique<Board>();
+    std::vector<int> occupied;
+    unsigned seed = 1;
+    long pieces = 0;
+    int passes;
+    char prefix[128];
+
+    std::snprintf(prefix, sizeof(prefix), "%5dx%-5d %-12s %-13s %3d%%", ROWS, COLS,
+        numOfKinds == NUM_OF_KINDS ? piece_maker<GAME_PIECE>::name() : "unique str", storageName, densityPercent);
+    // fill every cell with the probability of the density, the piece and the player are set by the cell
+    for (int i = 0; i < size; ++i) {
+        if ((int)(nextRandom(seed) % 100) < densityPercent) {
+            board->placePiece(i / COLS, i % COLS, piece_maker<GAME_PIECE>::make(i % numOfKinds), (i / NUM_OF_KINDS) % 2);
+            occupied.push_back(i);
+            ++pieces;
+        }
+    }
+    passes = (int)std::max(1L, NUM_OF_VISITS / std::max(1L, pieces));
+
+    // the pieces are replaced by the same pieces, to keep the board as it was filled
+    measure(prefix, "setPiece", [&] {
+        unsigned seed = 2;
+        if (occupied.empty()) {
+            return 0L;
+        }
+        for (int i = 0; i < NUM_OF_CALLS; ++i) {
+            int loc = occupied[nextRandom(seed) % occupied.size()];
+            board->setPiece(loc / COLS, loc % COLS, piece_maker<GAME_PIECE>::make(loc % numOfKinds), (loc / NUM_OF_KINDS) % 2);
+        }
+        return (long)NUM_OF_CALLS;
+    });
+    measure(prefix, "getPiece", [&] {
+        unsigned seed = 3;
+        long found = 0;
+        for (int i = 0; i < NUM_OF_CALLS; ++i) {
+            unsigned loc = nextRandom(seed) % size;
+            found += board->getPiece(loc / COLS, loc % COLS) != nullptr;
+        }
+        sink = found;
+        return (long)NUM_OF_CALLS;
+    });
+    measure(prefix, "iterate", [&] {
+        long visited = 0;
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto pieceInfo : *board) {
+                visited += std::get<3>(pieceInfo) >= 0;
+            }
+        }
+        return visited;
+    });
+    measure(prefix, "ofPlayer", [&] {
+        long visited = 0;
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto pieceInfo : board->allPiecesOfPlayer(0)) {
+                visited += std::get<3>(pieceInfo) >= 0;
+            }
+        }
+        return visited;
+    });
+    measure(prefix, "ofPiece", [&] {
+        long visited = 0;
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto pieceInfo : board->allOccureneceOfPiece(target)) {
+                visited += std::get<3>(pieceInfo) >= 0;
+            }
+        }
+        return visited;
+    });
+    measure(prefix, "ofPieceForPl", [&] {
+        long visited = 0;
+        for (int pass = 0; pass < passes; ++pass) {
+            for (auto pieceInfo : board->allOccureneceOfPieceForPlayer(target, 0)) {
+                visited += std::get<3>(pieceInfo) >= 0;
+            }
+        }
+        return visited;
+    });
+}
+
+// the benchmarks of a board size and piece type, for every density and storage
+template <int ROWS, int COLS, typename GAME_PIECE>
+static void benchmarkSize()
+{
+    for (int density : { 1, 10, 50, 100 }) {
+        benchmarkBoard<ROWS, COLS, GAME_PIECE, DenseStorage, NoIndex>("dense", density);
+        benchmarkBoard<ROWS, COLS, GAME_PIECE, DenseStorage, OccupancyIndex>("dense+index", density);
+        benchmarkBoard<ROWS, COLS, GAME_PIECE, SparseStorage, NoIndex>("sparse", density);
+    }
+}
+
+// the benchmarks of a board size with a piece value per cell, for every density, with and without the index
+template <int ROWS, int COLS>
+static void benchmarkUniqueSize()
+{
+    for (int density : { 1, 10, 50, 100 }) {
+        benchmarkBoard<ROWS, COLS, std::string, DenseStorage, NoIndex>("dense", density, ROWS * COLS);
+        benchmarkBoard<ROWS, COLS, std::string, DenseStorage, OccupancyIndex>("dense+index", density, ROWS * COLS);
+    }
+}
+
+// the benchmarks of a piece type, for every board size (up to 1024x1024 unless quick)
+template <typename GAME_PIECE>
+static void benchmarkType(bool quick)
+{
+    benchmarkSize<4, 3, GAME_PIECE>();
+    benchmarkSize<32, 32, GAME_PIECE>();
+    benchmarkSize<256, 256, GAME_PIECE>();
+    if (!quick) {
+        benchmarkSize<1024, 1024, GAME_PIECE>();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = argc > 1 && std::strcmp(argv[1], "-quick") == 0;
+
+    if (argc > 1 && !quick) {
+        std::cout << "Please call using the following format: <exe> [-quick]" << std::endl;
+        return -1;
+    }
+    std::printf("%-11s %-12s %-13s %4s %-14s %10s %10s\n", "board", "piece", "storage", "fill", "operation", "ns/op", "allocs/op");
+    benchmarkType<char>(quick);
+    benchmarkType<const char*>(quick);
+    benchmarkType<std::string>(quick);
+    // mostly unique pieces, every piece value has its own set in the index
+    benchmarkUniqueSize<4, 3>();
+    benchmarkUniqueSize<32, 32>();
+    benchmarkUniqueSize<256, 256>();
+    if (!quick) {
+        benchmarkUniqueSize<1024, 1024>();
+    }
+    return 0;
+}
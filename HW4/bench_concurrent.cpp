@@ -0,0 +1,101 @@
+/**
+ * @brief The throughput benchmark of the ConcurrentGameBoard: a single writer against a growing number of readers.
+ *
+ * @file bench_concurrent.cpp
+ * @author Yotam Sechayk
+ * @date 2018-06-27
+ */
+#include "ConcurrentGameBoard.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// the time each configuration runs
+#define RUN_MILLISECONDS 300
+// the maximal number of reader threads
+#define MAX_NUM_OF_READERS 8
+
+/**
+ * @brief Runs a writer and numOfReaders readers on a board for RUN_MILLISECONDS, and prints the throughput.
+ * Half of the readers read single cells, the other half take snapshots and iterate them.
+ *
+ * @tparam ROWS - the number of rows of the board
+ * @tparam COLS - the number of columns of the board
+ * @param numOfReaders - the number of reader threads
+ */
+template <int ROWS, int COLS>
+static void run(int numOfReaders)
+{
+    auto board = std::make_unique<ConcurrentGameBoard<ROWS, COLS, char>>();
+    std::vector<std::thread> readers;
+    std::atomic<bool> done(false);
+    std::atomic<long> numOfGets(0), numOfSnapshots(0);
+    long numOfWrites = 0;
+
+    for (int i = 0; i < ROWS * COLS; i += 3) {
+        board->setPiece(i / COLS, i % COLS, 'A' + i % 26, i % 2);
+    }
+    for (int t = 0; t < numOfReaders; ++t) {
+        readers.emplace_back([&, t] {
+            long count = 0;
+            unsigned seed = t + 1;
+            if (t % 2 == 0) {
+                while (!done) {
+                    seed = seed * 1103515245 + 12345;
+                    int loc = (seed >> 8) % (ROWS * COLS);
+                    board->getPiece(loc / COLS, loc % COLS);
+                    ++count;
+                }
+                numOfGets += count;
+            } else {
+                while (!done) {
+                    auto snapshot = board->snapshot();
+                    for (auto pieceInfo : *snapshot) {
+                        (void)pieceInfo;
+                    }
+                    ++count;
+                }
+                numOfSnapshots += count;
+            }
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto stop = start + std::chrono::milliseconds(RUN_MILLISECONDS);
+    unsigned seed = 0;
+    while (std::chrono::steady_clock::now() < stop) {
+        for (int i = 0; i < 64; ++i, ++numOfWrites) {
+            seed = seed * 1103515245 + 12345;
+            int loc = (seed >> 8) % (ROWS * COLS);
+            board->setPiece(loc / COLS, loc % COLS, 'A' + loc % 26, loc % 2);
+        }
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::setw(9) << std::to_string(ROWS) + "x" + std::to_string(COLS) << std::setw(9) << numOfReaders << std::fixed << std::setprecision(0)
+              << std::setw(14) << numOfWrites / seconds << std::setw(14) << numOfGets / seconds << std::setw(14) << numOfSnapshots / seconds << std::endl;
+}
+
+int main()
+{
+    std::cout << "ConcurrentGameBoard<char>, 1 writer, " << RUN_MILLISECONDS << "ms per run, "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+    std::cout << std::setw(9) << "board" << std::setw(9) << "readers" << std::setw(14) << "writes/s" << std::setw(14) << "gets/s"
+              << std::setw(14) << "snapshots/s" << std::endl;
+    for (int readers = 0; readers <= MAX_NUM_OF_READERS; readers = readers == 0 ? 1 : readers * 2) {
+        run<10, 10>(readers);
+    }
+    for (int readers = 0; readers <= MAX_NUM_OF_READERS; readers = readers == 0 ? 1 : readers * 2) {
+        run<128, 128>(readers);
+    }
+    return 0;
+}
@@ -1,6 +1,10 @@
+#include <atomic>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include "ConcurrentGameBoard.h"
 #include "ex4_header.h"
 #include "unit_test_util.h"
 
@@ -183,6 +187,373 @@ static bool test5()
     return true;
 }
 
+static bool test6()
+{
+    GameBoard<4, 3, string> board;
+
+	ASSERT_TRUE(board.placePiece(0, 0, "aaa", 1));
+	ASSERT_TRUE(board.placePiece(3, 2, "bbb", 0));
+	ASSERT_FALSE(board.placePiece(4, 0, "ccc", 0));
+	ASSERT_FALSE(board.placePiece(0, 0, "ccc", 2));
+	ASSERT_TRUE(board.findPiece(1, 1) == nullptr);
+	ASSERT_TRUE(board.findPiece(-1, 0) == nullptr);
+	auto a = board.findPiece(0, 0);
+	ASSERT_TRUE(a != nullptr && a->first == 1 && a->second == "aaa");
+	auto b = board.setPiece(3, 2, "ddd", 1);
+	ASSERT_TRUE(b != nullptr && b->first == 0 && b->second == "bbb");
+	ASSERT_TRUE(board.findPiece(3, 2)->second == "ddd");
+	int counter = 0;
+	for (auto pieceInfo : board) {
+		ASSERT_TRUE(get<3>(pieceInfo) == 1);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 2);
+    return true;
+}
+
+static bool test7()
+{
+    GameBoard<4, 3, char> board;
+    int i = 0;
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 3; col++) {
+            ASSERT_TRUE(board.setPiece(row, col, 'A'+i, i) == nullptr);
+            i = (i + 1) % 2;
+        }
+    }
+	// an early exit leaves nothing behind
+	for (auto pieceInfo : board.allPiecesOfPlayer(1)) {
+		ASSERT_TRUE(get<3>(pieceInfo) == 1);
+		break;
+	}
+	int counter = 0;
+	for (auto pieceInfo : board) {
+		(void)pieceInfo;
+		++counter;
+	}
+	ASSERT_TRUE(counter == 12);
+	// nested views of the same board
+	counter = 0;
+	for (auto a : board.allOccureneceOfPiece('A')) {
+		for (auto b : board.allPiecesOfPlayer(1)) {
+			ASSERT_TRUE(get<2>(a) == 'A' && get<3>(b) == 1);
+			++counter;
+		}
+	}
+	ASSERT_TRUE(counter == 36);
+	counter = 0;
+	for (auto pieceInfo : board.filter([](const std::pair<int, char>& p) { return p.second == 'B' && p.first == 1; })) {
+		ASSERT_TRUE(get<2>(pieceInfo) == 'B' && get<3>(pieceInfo) == 1);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 6);
+    return true;
+}
+
+// a piece type without std::hash, only the players are indexed
+struct plain_piece {
+	int _M_kind;
+	bool operator==(const plain_piece& other) const { return _M_kind == other._M_kind; }
+};
+
+static bool test8()
+{
+	// a large board with a few pieces
+	auto board = std::make_unique<GameBoard<1000, 1000, string, 3, DenseStorage, OccupancyIndex>>();
+	ASSERT_TRUE(board->setPiece(999, 999, "aaa", 2) == nullptr);
+	ASSERT_TRUE(board->setPiece(0, 5, "aaa", 0) == nullptr);
+	ASSERT_TRUE(board->setPiece(500, 0, "bbb", 2) == nullptr);
+	ASSERT_TRUE(board->placePiece(70, 70, "aaa", 2));
+	int counter = 0, last = -1;
+	for (auto pieceInfo : board->allPiecesOfPlayer(2)) {
+		ASSERT_TRUE(get<3>(pieceInfo) == 2);
+		ASSERT_TRUE(get<0>(pieceInfo) * 1000 + get<1>(pieceInfo) > last);
+		last = get<0>(pieceInfo) * 1000 + get<1>(pieceInfo);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 3);
+	counter = 0;
+	for (auto pieceInfo : board->allOccureneceOfPieceForPlayer("aaa", 2)) {
+		ASSERT_TRUE(get<2>(pieceInfo) == "aaa" && get<3>(pieceInfo) == 2);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 2);
+	// replacing and overwriting pieces keeps the index in sync
+	auto prev = board->setPiece(70, 70, "bbb", 1);
+	ASSERT_TRUE(prev != nullptr && prev->second == "aaa" && prev->first == 2);
+	ASSERT_TRUE(board->placePiece(999, 999, "ccc", 0));
+	counter = 0;
+	for (auto pieceInfo : board->allOccureneceOfPiece("aaa")) {
+		ASSERT_TRUE(get<0>(pieceInfo) == 0 && get<1>(pieceInfo) == 5);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 1);
+	counter = 0;
+	for (auto pieceInfo : board->allOccureneceOfPiece("bbb")) {
+		(void)pieceInfo;
+		++counter;
+	}
+	ASSERT_TRUE(counter == 2);
+	ASSERT_TRUE(board->allOccureneceOfPiece("zzz").begin() == board->allOccureneceOfPiece("zzz").end());
+	ASSERT_TRUE(board->allPiecesOfPlayer(7).begin() == board->allPiecesOfPlayer(7).end());
+
+	// the indexed views see the same pieces as a plain board
+	GameBoard<5, 7, char, 2, DenseStorage, OccupancyIndex> indexed;
+	GameBoard<5, 7, char> plain;
+	for (int i = 0; i < 60; i++) {
+		int row = (i * 7) % 5, col = (i * 3) % 7, player = i % 2;
+		char piece = 'A' + i % 4;
+		indexed.setPiece(row, col, piece, player);
+		plain.setPiece(row, col, piece, player);
+	}
+	for (char piece = 'A'; piece <= 'D'; piece++) {
+		auto a = indexed.allOccureneceOfPieceForPlayer(piece, 1).begin();
+		auto b = plain.allOccureneceOfPieceForPlayer(piece, 1).begin();
+		for (; b != plain.allOccureneceOfPieceForPlayer(piece, 1).end(); ++a, ++b) {
+			ASSERT_TRUE(*a == *b);
+		}
+		ASSERT_TRUE(a == indexed.allOccureneceOfPieceForPlayer(piece, 1).end());
+	}
+
+	// unhashable pieces fall back to scanning
+	GameBoard<4, 3, plain_piece, 2, DenseStorage, OccupancyIndex> unhashable;
+	unhashable.setPiece(1, 1, plain_piece { 1 }, 0);
+	unhashable.setPiece(2, 1, plain_piece { 1 }, 1);
+	counter = 0;
+	for (auto pieceInfo : unhashable.allOccureneceOfPiece(plain_piece { 1 })) {
+		(void)pieceInfo;
+		++counter;
+	}
+	ASSERT_TRUE(counter == 2);
+    return true;
+}
+
+static bool test9()
+{
+	// a board of 2^30 cells, the storage holds only the tiles with pieces
+	GameBoard<32768, 32768, string, 2, SparseStorage> board;
+	ASSERT_TRUE(sizeof(board) < 1024);
+	ASSERT_TRUE(board.setPiece(32767, 32767, "zzz", 1) == nullptr);
+	ASSERT_TRUE(board.setPiece(0, 0, "aaa", 0) == nullptr);
+	ASSERT_TRUE(board.setPiece(0, 63, "bbb", 1) == nullptr);
+	ASSERT_TRUE(board.setPiece(12345, 678, "ccc", 0) == nullptr);
+	ASSERT_TRUE(board.getPiece(5, 5) == nullptr);
+	ASSERT_TRUE(board.getPiece(32768, 0) == nullptr);
+	auto prev = board.setPiece(0, 63, "ddd", 0);
+	ASSERT_TRUE(prev != nullptr && prev->first == 1 && prev->second == "bbb");
+	ASSERT_TRUE(board.getPiece(0, 63)->second == "ddd");
+	// row-major order
+	const int rows[] = { 0, 0, 12345, 32767 };
+	const int cols[] = { 0, 63, 678, 32767 };
+	int counter = 0;
+	for (auto pieceInfo : board) {
+		ASSERT_TRUE(get<0>(pieceInfo) == rows[counter] && get<1>(pieceInfo) == cols[counter]);
+		++counter;
+	}
+	ASSERT_TRUE(counter == 4);
+	counter = 0;
+	for (auto pieceInfo : board.allPiecesOfPlayer(0)) {
+		(void)pieceInfo;
+		++counter;
+	}
+	ASSERT_TRUE(counter == 3);
+
+	// the same semantics as the dense storage
+	GameBoard<9, 13, char, 2, SparseStorage> sparse;
+	GameBoard<9, 13, char> dense;
+	for (int i = 0; i < 200; i++) {
+		int row = (i * 5) % 9, col = (i * 11) % 13, player = i % 2;
+		auto a = sparse.setPiece(row, col, 'a' + i % 3, player);
+		auto b = dense.setPiece(row, col, 'a' + i % 3, player);
+		ASSERT_TRUE((a == nullptr) == (b == nullptr));
+		ASSERT_TRUE(a == nullptr || *a == *b);
+	}
+	auto a = sparse.begin();
+	for (auto b = dense.begin(); b != dense.end(); ++a, ++b) {
+		ASSERT_TRUE(*a == *b);
+	}
+	ASSERT_TRUE(a == sparse.end());
+    return true;
+}
+
+static bool test10()
+{
+	// one writer moves 10 pieces around, every move is a single write
+	ConcurrentGameBoard<8, 8, char> board;
+	const int numOfPieces = 10, numOfMoves = 20000;
+	std::atomic<bool> done(false);
+	std::atomic<int> numOfErrors(0), numOfSnapshots(0);
+	std::vector<std::thread> readers;
+
+	for (int i = 0; i < numOfPieces; i++) {
+		board.setPiece(i / 8, i % 8, 'a' + i, i % 2);
+	}
+	for (int t = 0; t < 3; t++) {
+		readers.emplace_back([&] {
+			while (!done) {
+				int counter = 0, seen = 0;
+				auto snapshot = board.snapshot();
+				for (auto pieceInfo : *snapshot) {
+					seen |= 1 << (get<2>(pieceInfo) - 'a');
+					if ((get<2>(pieceInfo) - 'a') % 2 != get<3>(pieceInfo)) {
+						++numOfErrors;
+					}
+					++counter;
+				}
+				if (counter != numOfPieces || seen != (1 << numOfPieces) - 1) {
+					++numOfErrors;
+				}
+				for (int i = 0; i < 64; i++) {
+					auto piece = board.getPiece(i / 8, i % 8);
+					if (piece != nullptr && (piece->second - 'a') % 2 != piece->first) {
+						++numOfErrors;
+					}
+				}
+				++numOfSnapshots;
+			}
+		});
+	}
+	unsigned seed = 7;
+	for (int move = 0; move < numOfMoves; move++) {
+		seed = seed * 1103515245 + 12345;
+		int from = (seed >> 8) % 64, to = (seed >> 16) % 64;
+		board.update([&](ConcurrentGameBoard<8, 8, char>::transaction& tx) {
+			if (tx.getPiece(from / 8, from % 8) == nullptr || tx.getPiece(to / 8, to % 8) != nullptr) {
+				return;
+			}
+			auto piece = tx.removePiece(from / 8, from % 8);
+			tx.setPiece(to / 8, to % 8, piece->second, piece->first);
+		});
+		if (move % 1000 == 0) {
+			std::this_thread::yield();
+		}
+	}
+	done = true;
+	for (auto& reader : readers) {
+		reader.join();
+	}
+	ASSERT_TRUE(numOfErrors == 0);
+	ASSERT_TRUE(numOfSnapshots > 0);
+	ASSERT_TRUE(board.getVersion() == numOfPieces + numOfMoves);
+	ASSERT_TRUE(board.getPiece(8, 0) == nullptr);
+	ASSERT_TRUE(board.setPiece(0, 0, 'x', 2) == nullptr);
+    return true;
+}
+
+// a piece counting its copies
+struct counted_piece {
+	static int _M_copies;
+	std::string _M_name;
+	counted_piece(const char* name = "") : _M_name(name) {}
+	counted_piece(const counted_piece& other) : _M_name(other._M_name) { ++_M_copies; }
+	counted_piece(counted_piece&&) = default;
+	counted_piece& operator=(const counted_piece& other) { _M_name = other._M_name; ++_M_copies; return *this; }
+	counted_piece& operator=(counted_piece&&) = default;
+	bool operator==(const counted_piece& other) const { return _M_name == other._M_name; }
+};
+int counted_piece::_M_copies = 0;
+
+static bool test11()
+{
+	GameBoard<4, 3, counted_piece> board;
+	counted_piece::_M_copies = 0;
+	ASSERT_TRUE(board.emplacePiece(0, 0, 1, "rock") == nullptr);
+	auto prev = board.emplacePiece(0, 0, 0, "paper");
+	ASSERT_TRUE(prev != nullptr && prev->first == 1 && prev->second._M_name == "rock");
+	ASSERT_TRUE(board.emplacePiece(4, 0, 0, "paper") == nullptr);
+	ASSERT_TRUE(counted_piece::_M_copies == 0);
+
+	// moving a piece
+	PieceInfo<counted_piece> captured;
+	ASSERT_TRUE(board.emplacePiece(2, 2, 1, "scissors") == nullptr);
+	ASSERT_TRUE(board.movePiece(0, 0, 1, 1, &captured));
+	ASSERT_TRUE(captured == nullptr);
+	ASSERT_TRUE(board.findPiece(0, 0) == nullptr && board.findPiece(1, 1)->second._M_name == "paper");
+	ASSERT_TRUE(board.movePiece(1, 1, 2, 2, &captured));
+	ASSERT_TRUE(captured != nullptr && captured->first == 1 && captured->second._M_name == "scissors");
+	ASSERT_TRUE(board.findPiece(2, 2)->first == 0);
+	ASSERT_TRUE(board.movePiece(2, 2, 2, 2));
+	ASSERT_FALSE(board.movePiece(0, 0, 1, 1));
+	ASSERT_FALSE(board.movePiece(2, 2, 4, 0));
+	ASSERT_TRUE(counted_piece::_M_copies == 0);
+
+	// clear and bulk assign, the indexed and sparse boards too
+	board.clear();
+	ASSERT_TRUE(board.begin() == board.end());
+	GameBoard<4, 3, string> source;
+	source.setPiece(0, 1, "aaa", 0);
+	source.setPiece(3, 2, "bbb", 1);
+	source.setPiece(1, 0, "aaa", 1);
+	GameBoard<4, 3, string, 2, SparseStorage> sparse;
+	sparse.setPiece(2, 2, "zzz", 0);
+	ASSERT_TRUE(sparse.assign(source.begin(), source.end()) == 3);
+	auto a = sparse.begin();
+	for (auto b = source.begin(); b != source.end(); ++a, ++b) {
+		ASSERT_TRUE(*a == *b);
+	}
+	ASSERT_TRUE(a == sparse.end());
+	GameBoard<4, 3, string, 2, DenseStorage, OccupancyIndex> indexed;
+	std::vector<std::tuple<int, int, string, int>> pieces = { std::make_tuple(0, 0, "aaa", 1), std::make_tuple(9, 0, "bad", 1),
+		std::make_tuple(2, 1, "aaa", 1), std::make_tuple(2, 2, "bbb", 0) };
+	ASSERT_TRUE(indexed.assign(std::make_move_iterator(pieces.begin()), std::make_move_iterator(pieces.end())) == 3);
+	int counter = 0;
+	for (auto pieceInfo : indexed.allOccureneceOfPieceForPlayer("aaa", 1)) {
+		(void)pieceInfo;
+		++counter;
+	}
+	ASSERT_TRUE(counter == 2);
+	ASSERT_TRUE(indexed.movePiece(0, 0, 2, 2));
+	indexed.clear();
+	ASSERT_TRUE(indexed.allPiecesOfPlayer(1).begin() == indexed.allPiecesOfPlayer(1).end());
+    return true;
+}
+
+// a piece that can't be default constructed or assigned, counting the pieces alive
+struct fixed_piece {
+	static int _M_alive;
+	const int _M_kind;
+	explicit fixed_piece(int kind) : _M_kind(kind) { ++_M_alive; }
+	fixed_piece(const fixed_piece& other) : _M_kind(other._M_kind) { ++_M_alive; }
+	~fixed_piece() { --_M_alive; }
+	fixed_piece& operator=(const fixed_piece&) = delete;
+	bool operator==(const fixed_piece& other) const { return _M_kind == other._M_kind; }
+};
+int fixed_piece::_M_alive = 0;
+
+template <template <int, int, typename> class STORAGE>
+static bool testFixedPieces()
+{
+	{
+		GameBoard<4, 70, fixed_piece, 2, STORAGE> board;
+		ASSERT_TRUE(board.setPiece(0, 0, fixed_piece(1), 0) == nullptr);
+		ASSERT_TRUE(board.setPiece(3, 69, fixed_piece(2), 1) == nullptr);
+		auto prev = board.setPiece(0, 0, fixed_piece(2), 1);
+		ASSERT_TRUE(prev != nullptr && prev->second._M_kind == 1);
+		prev.reset();
+		ASSERT_TRUE(board.movePiece(0, 0, 1, 5));
+		int counter = 0;
+		for (auto pieceInfo : board.allOccureneceOfPiece(fixed_piece(2))) {
+			counter += get<3>(pieceInfo);
+		}
+		ASSERT_TRUE(counter == 2);
+		// the empty cells hold no piece
+		ASSERT_TRUE(fixed_piece::_M_alive == 2);
+		ASSERT_TRUE(board.movePiece(1, 5, 3, 69));
+		ASSERT_TRUE(fixed_piece::_M_alive == 1);
+		board.setPiece(2, 2, fixed_piece(3), 0);
+	}
+	// and the board destroys the pieces it holds
+	ASSERT_TRUE(fixed_piece::_M_alive == 0);
+	return true;
+}
+
+static bool test12()
+{
+	ASSERT_TRUE(testFixedPieces<DenseStorage>());
+	ASSERT_TRUE(testFixedPieces<SparseStorage>());
+	return true;
+}
+
 int main()
 {
     RUN_TEST(test1);
@@ -190,5 +561,12 @@ int main()
     RUN_TEST(test3);
     RUN_TEST(test4);
     RUN_TEST(test5);
+    RUN_TEST(test6);
+    RUN_TEST(test7);
+    RUN_TEST(test8);
+    RUN_TEST(test9);
+    RUN_TEST(test10);
+    RUN_TEST(test11);
+    RUN_TEST(test12);
     return 0;
 }